@@ -399,6 +399,30 @@ namespace Brainiac {
         return static_cast<Square>(__builtin_popcountll(bitboard));
     }
 
+    /**
+     * @brief Gather the bits selected by a mask into the low bits (parallel
+     * bit extract). This emits the BMI2 `pext` instruction on x86-64, so the
+     * caller must check that the CPU supports it.
+     *
+     * @param bitboard
+     * @param mask
+     * @return Bitboard
+     */
+    inline Bitboard pext_bitboard(Bitboard bitboard, Bitboard mask) {
+#if defined(__x86_64__)
+        Bitboard result;
+        asm("pextq %2, %1, %0" : "=r"(result) : "r"(bitboard), "rm"(mask));
+        return result;
+#else
+        Bitboard result = 0;
+        for (Bitboard bit = 1; mask; bit <<= 1) {
+            if (bitboard & mask & -mask) result |= bit;
+            mask &= mask - 1;
+        }
+        return result;
+#endif
+    }
+
     /**
      * @brief Flip a bitboard vertically.
      *
@@ -425,6 +449,32 @@ namespace Brainiac {
         return bitboard;
     }
 
+    /**
+     * @brief Fill each set bit towards the 8th rank.
+     *
+     * @param bitboard
+     * @return constexpr Bitboard
+     */
+    constexpr Bitboard fill_north_bitboard(Bitboard bitboard) {
+        bitboard |= bitboard << 8;
+        bitboard |= bitboard << 16;
+        bitboard |= bitboard << 32;
+        return bitboard;
+    }
+
+    /**
+     * @brief Fill each set bit towards the 1st rank.
+     *
+     * @param bitboard
+     * @return constexpr Bitboard
+     */
+    constexpr Bitboard fill_south_bitboard(Bitboard bitboard) {
+        bitboard |= bitboard >> 8;
+        bitboard |= bitboard >> 16;
+        bitboard |= bitboard >> 32;
+        return bitboard;
+    }
+
     /**
      * @brief Get the least significant bit.
      *
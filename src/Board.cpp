@@ -4,6 +4,8 @@ namespace Brainiac {
     Board::Board() {
         std::fill(_bitboards.begin(), _bitboards.end(), 0);
         std::fill(_pieces.begin(), _pieces.end(), Piece::Empty);
+        _material = 0;
+        _placement = 0;
     }
 
     Bitboard Board::bitboard(Color color) const {
@@ -14,6 +16,10 @@ namespace Brainiac {
 
     Piece Board::get(Square sq) const { return _pieces[sq]; }
 
+    Value Board::material() const { return _material; }
+
+    Value Board::placement() const { return _placement; }
+
     void Board::set(Square sq, Piece piece) {
         Piece prev_piece = get(sq);
         Bitboard set_mask = 1ULL << sq;
@@ -27,6 +33,11 @@ namespace Brainiac {
         _bitboards[13 + (piece >= 6)] |= set_mask;
         _bitboards[piece] |= set_mask;
 
+        // Swap the scores of the previous piece for the new one
+        _material += MATERIAL_SCORES[piece] - MATERIAL_SCORES[prev_piece];
+        _placement +=
+            PLACEMENT_SCORES[piece][sq] - PLACEMENT_SCORES[prev_piece][sq];
+
         // Update mailbox
         _pieces[sq] = piece;
     }
@@ -38,6 +49,9 @@ namespace Brainiac {
         _bitboards[13 + (piece >= 6)] &= mask;
         _bitboards[piece] &= mask;
 
+        _material -= MATERIAL_SCORES[piece];
+        _placement -= PLACEMENT_SCORES[piece][sq];
+
         _pieces[sq] = Piece::Empty;
     }
 
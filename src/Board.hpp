@@ -5,7 +5,9 @@
 
 #include "Bitboard.hpp"
 #include "Move.hpp"
+#include "Numeric.hpp"
 #include "Piece.hpp"
+#include "PieceSquare.hpp"
 
 namespace Brainiac {
     /**
@@ -26,6 +28,20 @@ namespace Brainiac {
          */
         std::array<Piece, 64> _pieces;
 
+        /**
+         * @brief Material score from white's perspective, updated as pieces
+         * are set and cleared.
+         *
+         */
+        Value _material;
+
+        /**
+         * @brief Placement score from white's perspective, updated as pieces
+         * are set and cleared.
+         *
+         */
+        Value _placement;
+
       public:
         /**
          * @brief Construct a Board.
@@ -57,6 +73,20 @@ namespace Brainiac {
          */
         Piece get(Square sq) const;
 
+        /**
+         * @brief Get the material score from white's perspective.
+         *
+         * @return Value
+         */
+        Value material() const;
+
+        /**
+         * @brief Get the placement score from white's perspective.
+         *
+         * @return Value
+         */
+        Value placement() const;
+
         /**
          * @brief Set the piece at a given square.
          *
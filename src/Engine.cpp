@@ -2,8 +2,7 @@
 
 namespace Brainiac {
     void init() {
-        ROOK_ATTACK_TABLES = Brainiac::init_rook_tables();
-        BISHOP_ATTACK_TABLES = Brainiac::init_bishop_tables();
+        init_slider_tables();
     }
 
     std::string get_engine_version() { return "v1.0"; }
@@ -1,16 +1,23 @@
 #include "Bitboard.hpp"
 #include "Board.hpp"
+#include "EvalCache.hpp"
 #include "Evaluation.hpp"
 #include "History.hpp"
+#include "Killers.hpp"
 #include "Move.hpp"
 #include "MoveGen.hpp"
 #include "MoveList.hpp"
+#include "MovePicker.hpp"
+#include "PawnTable.hpp"
 #include "Perft.hpp"
 #include "Piece.hpp"
 #include "Position.hpp"
 #include "Search.hpp"
 #include "Sliders.hpp"
 #include "State.hpp"
+#include "StaticExchange.hpp"
+#include "TableStats.hpp"
+#include "ThreadPool.hpp"
 #include "Transpositions.hpp"
 #include "UCI.hpp"
 #include "Utils.hpp"
@@ -0,0 +1,43 @@
+#include "EvalCache.hpp"
+
+namespace Brainiac {
+    EvalCache::EvalCache(std::size_t megabytes) : _size(0) {
+        resize(megabytes);
+    }
+
+    uint64_t &EvalCache::slot(Hash hash) const {
+        // Map the low 32 bits onto [0, size) so any size can be indexed
+        return _entries[(static_cast<uint32_t>(hash) * _size) >> 32];
+    }
+
+    void EvalCache::resize(std::size_t megabytes) {
+        megabytes = std::clamp(megabytes, std::size_t(1), MAX_EVAL_CACHE_MB);
+        _size = (megabytes << 20) / sizeof(uint64_t);
+        _entries = std::make_unique<uint64_t[]>(_size);
+    }
+
+    std::size_t EvalCache::capacity() const { return _size; }
+
+    bool EvalCache::get(Hash hash, Value &value, TableStats *stats) const {
+        if (stats) TableStats::increment(stats->probes);
+
+        uint64_t entry = std::atomic_ref<uint64_t>(slot(hash)).load(
+            std::memory_order_relaxed);
+        if (!entry || (entry ^ hash) >> 16) return false;
+
+        if (stats) TableStats::increment(stats->hits);
+        value = std::bit_cast<Value>(static_cast<uint16_t>(entry));
+        return true;
+    }
+
+    void EvalCache::set(Hash hash, Value value) {
+        uint64_t entry = (hash & ~uint64_t(0xFFFF)) |
+                         std::bit_cast<uint16_t>(value);
+        std::atomic_ref<uint64_t>(slot(hash)).store(entry,
+                                                    std::memory_order_relaxed);
+    }
+
+    void EvalCache::clear() {
+        std::memset(_entries.get(), 0, _size * sizeof(uint64_t));
+    }
+} // namespace Brainiac
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+#include "Hasher.hpp"
+#include "Numeric.hpp"
+#include "TableStats.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Default size of the evaluation cache in megabytes.
+     *
+     */
+    constexpr std::size_t DEFAULT_EVAL_CACHE_MB = 4;
+
+    /**
+     * @brief Maximum size of the evaluation cache in megabytes.
+     *
+     */
+    constexpr std::size_t MAX_EVAL_CACHE_MB = 1 << 10;
+
+    /**
+     * @brief Direct-mapped cache of static evaluations shared by all search
+     * threads.
+     *
+     * Each slot is a single 64-bit word holding the top 48 bits of the hash
+     * and the 16-bit value, so it is read and written atomically without
+     * locks. Colliding positions simply replace each other.
+     *
+     */
+    class EvalCache {
+        std::unique_ptr<uint64_t[]> _entries;
+        std::size_t _size;
+
+        /**
+         * @brief Get the slot of a hash.
+         *
+         * @param hash
+         * @return uint64_t&
+         */
+        uint64_t &slot(Hash hash) const;
+
+      public:
+        /**
+         * @brief Construct a cache of a given size in megabytes.
+         *
+         * @param megabytes
+         */
+        EvalCache(std::size_t megabytes = DEFAULT_EVAL_CACHE_MB);
+
+        /**
+         * @brief Reallocate the cache to a given size in megabytes. This also
+         * clears the cache.
+         *
+         * @param megabytes
+         */
+        void resize(std::size_t megabytes);
+
+        /**
+         * @brief Get the number of entries the cache can hold.
+         *
+         * @return std::size_t
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Read the cached evaluation of a position.
+         *
+         * @param hash
+         * @param value Set to the cached value on a hit
+         * @param stats Optional counters to update
+         * @return true if the position was found
+         */
+        bool get(Hash hash, Value &value, TableStats *stats = nullptr) const;
+
+        /**
+         * @brief Store the evaluation of a position.
+         *
+         * @param hash
+         * @param value
+         */
+        void set(Hash hash, Value value);
+
+        /**
+         * @brief Clear the cache.
+         *
+         */
+        void clear();
+    };
+} // namespace Brainiac
\ No newline at end of file
@@ -71,22 +71,152 @@ namespace Brainiac {
         return total;
     }
 
-    Value evaluate(Position &pos) {
+    PawnEntry compute_pawn_structure(const Board &board) {
+        Bitboard white = board.bitboard(Piece::WhitePawn);
+        Bitboard black = board.bitboard(Piece::BlackPawn);
+
+        PawnEntry entry;
+        entry.attacks[Color::White] =
+            ((white & ~FILES[0]) << 7) | ((white & ~FILES[7]) << 9);
+        entry.attacks[Color::Black] =
+            ((black & ~FILES[0]) >> 9) | ((black & ~FILES[7]) >> 7);
+        entry.attack_spans[Color::White] =
+            fill_north_bitboard(entry.attacks[Color::White]);
+        entry.attack_spans[Color::Black] =
+            fill_south_bitboard(entry.attacks[Color::Black]);
+
+        // Passed pawns cannot be blocked or captured by enemy pawns
+        Bitboard white_front = fill_north_bitboard(white << 8);
+        Bitboard black_front = fill_south_bitboard(black >> 8);
+        entry.passed[Color::White] =
+            white & ~(black_front | entry.attack_spans[Color::Black]);
+        entry.passed[Color::Black] =
+            black & ~(white_front | entry.attack_spans[Color::White]);
+
+        for (Color color : {Color::White, Color::Black}) {
+            Bitboard pawns = color == Color::White ? white : black;
+            Bitboard files = fill_north_bitboard(fill_south_bitboard(pawns));
+            Bitboard neighbors =
+                ((files & ~FILES[0]) >> 1) | ((files & ~FILES[7]) << 1);
+            Bitboard behind = color == Color::White
+                                  ? fill_north_bitboard(pawns << 8)
+                                  : fill_south_bitboard(pawns >> 8);
+
+            Value score = 0;
+            score -= count_set_bitboard(pawns & ~neighbors) *
+                     ISOLATED_PAWN_PENALTY;
+            score -= count_set_bitboard(pawns & behind) * DOUBLED_PAWN_PENALTY;
+
+            Bitboard passed = entry.passed[color];
+            while (passed) {
+                unsigned rank = find_lsb_bitboard(passed) / 8;
+                if (color == Color::Black) rank = 7 - rank;
+                score += PASSED_PAWN_BONUS[rank];
+                passed = pop_lsb_bitboard(passed);
+            }
+
+            entry.value[color] = score;
+        }
+
+        return entry;
+    }
+
+    /**
+     * @brief Combine the evaluation terms of a position.
+     *
+     * @param pos
+     * @param pawns
+     * @return Value
+     */
+    static Value evaluate_terms(Position &pos, const PawnEntry &pawns) {
         Value sign = (pos.turn() << 1) - 1;
+        const Board &board = pos.board();
+        Value material = board.material();
+        Value placement = board.placement();
+
+        Value pawn_structure =
+            pawns.value[Color::White] - pawns.value[Color::Black];
+
+        return -sign * (4 * material + placement + pawn_structure);
+    }
 
+    Value evaluate_checkmate(const Position &pos) {
+        Value sign = (pos.turn() << 1) - 1;
+        return -sign * WIN_VALUE;
+    }
+
+    Value evaluate(Position &pos) {
         // Leaf node
         if (pos.is_checkmate()) {
-            return -sign * WIN_VALUE;
+            return evaluate_checkmate(pos);
         }
         if (pos.is_draw()) {
             return 0;
         }
 
         // Non-leaf node (depth capped)
-        const Board &board = pos.board();
-        Value material = compute_material(board);
-        Value placement = compute_placement(board);
+        return evaluate_terms(pos, compute_pawn_structure(pos.board()));
+    }
+
+    /**
+     * @brief Evaluate a non-terminal position, reading the pawn structure
+     * from a pawn hash table.
+     *
+     * @param pos
+     * @param ptable
+     * @return Value
+     */
+    static Value evaluate_static(Position &pos, PawnTable &ptable) {
+        bool hit;
+        Hash key = pos.pawn_hash();
+        PawnEntry &entry = ptable.probe(key, hit);
+        if (!hit) {
+            entry = compute_pawn_structure(pos.board());
+            entry.key = key;
+        }
+        return evaluate_terms(pos, entry);
+    }
+
+    Value evaluate(Position &pos, PawnTable &ptable) {
+        // Leaf node
+        if (pos.is_checkmate()) {
+            return evaluate_checkmate(pos);
+        }
+        if (pos.is_draw()) {
+            return 0;
+        }
+
+        // Non-leaf node (depth capped)
+        return evaluate_static(pos, ptable);
+    }
 
-        return -sign * (4 * material + placement);
+    Value evaluate(Position &pos,
+                   PawnTable &ptable,
+                   EvalCache &ecache,
+                   TableStats *stats) {
+        // Leaf node
+        if (pos.is_checkmate()) {
+            return evaluate_checkmate(pos);
+        }
+        if (pos.is_draw()) {
+            return 0;
+        }
+
+        // Non-leaf node (depth capped)
+        return evaluate_static(pos, ptable, ecache, stats);
+    }
+
+    Value evaluate_static(Position &pos,
+                          PawnTable &ptable,
+                          EvalCache &ecache,
+                          TableStats *stats) {
+        // The hash includes the turn
+        Value value;
+        if (ecache.get(pos.hash(), value, stats)) {
+            return value;
+        }
+        value = evaluate_static(pos, ptable);
+        ecache.set(pos.hash(), value);
+        return value;
     }
 } // namespace Brainiac
\ No newline at end of file
@@ -2,105 +2,43 @@
 
 #include <array>
 
+#include "EvalCache.hpp"
 #include "Numeric.hpp"
+#include "PawnTable.hpp"
+#include "PieceSquare.hpp"
 #include "Position.hpp"
 
 namespace Brainiac {
     /**
-     * @brief Piece weights from white's perspective.
+     * @brief Passed pawn bonus by rank, relative to the pawn's color.
      *
      */
-    constexpr std::array<Value, 12> PIECE_WEIGHTS = {
-        100,
+    constexpr std::array<Value, 8> PASSED_PAWN_BONUS = {
+        0,
+        5,
         10,
-        50,
-        32,
-        33,
-        90,
-        -100,
-        -10,
-        -50,
-        -32,
-        -33,
-        -90,
+        15,
+        25,
+        40,
+        60,
+        0,
     };
 
     /**
-     * @brief The matrices below determine the placement scores of each piece
-     * on the board.
+     * @brief Penalty for a pawn without friendly pawns on adjacent files.
      *
-     * The higher the score at a particular index, the more favorable
-     * that location for that piece.
+     */
+    constexpr Value ISOLATED_PAWN_PENALTY = 10;
+
+    /**
+     * @brief Penalty for a pawn with a friendly pawn behind it on its file.
      *
-     * Note that value placement is from the perspective of white from the
-     * visual representation of the board, i.e., starting position is on the
-     * bottom 2 rows.
      */
-    // clang-format off
-    constexpr std::array<Value, 64> QUEEN_MATRIX = {
-        -20,-10,-10, -5, -5,-10,-10,-20,
-        -10,  0,  0,  0,  0,  0,  0,-10,
-        -10,  0,  5,  5,  5,  5,  0,-10,
-        -5,  0,  5,  5,  5,  5,  0, -5,
-        0,  0,  5,  5,  5,  5,  0, -5,
-        -10,  5,  5,  5,  5,  5,  0,-10,
-        -10,  0,  5,  0,  0,  0,  0,-10,
-        -20,-10,-10, -5, -5,-10,-10,-20
-    };
-    constexpr std::array<Value, 64> BISHOP_MATRIX = {
-        -20,-10,-10,-10,-10,-10,-10,-20,
-        -10,  0,  0,  0,  0,  0,  0,-10,
-        -10,  0,  5, 10, 10,  5,  0,-10,
-        -10,  5,  5, 10, 10,  5,  5,-10,
-        -10,  0, 10, 10, 10, 10,  0,-10,
-        -10, 10, 10, 10, 10, 10, 10,-10,
-        -10,  5,  0,  0,  0,  0,  5,-10,
-        -20,-10,-10,-10,-10,-10,-10,-20,
-    };
-    constexpr std::array<Value, 64> KNIGHT_MATRIX = {
-        -50,-40,-30,-30,-30,-30,-40,-50,
-        -40,-20,  0,  0,  0,  0,-20,-40,
-        -30,  0, 10, 15, 15, 10,  0,-30,
-        -30,  5, 15, 20, 20, 15,  5,-30,
-        -30,  0, 15, 20, 20, 15,  0,-30,
-        -30,  5, 10, 15, 15, 10,  5,-30,
-        -40,-20,  0,  5,  5,  0,-20,-40,
-        -50,-40,-30,-30,-30,-30,-40,-50,
-    };
-    constexpr std::array<Value, 64> ROOK_MATRIX = {
-        0,  0,  0,  0,  0,  0,  0,  0,
-        5, 10, 10, 10, 10, 10, 10,  5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        -5,  0,  0,  0,  0,  0,  0, -5,
-        0,  0,  0,  5,  5,  0,  0,  0
-    };
-    constexpr std::array<Value, 64> PAWN_MATRIX = {
-        0,  0,  0,  0,  0,  0,  0,  0,
-        70, 70, 70, 70, 70, 70, 70, 70,
-        10, 10, 20, 40, 40, 20, 10, 10,
-        5,  5, 10, 35, 35, 10,  5,  5,
-        0,  0,  0, 30, 30,  0,  0,  0,
-        5, -5,-10,  0,  0,-10, -5,  5,
-        5, 10, 10,-20,-20, 10, 10,  5,
-        0,  0,  0,  0,  0,  0,  0,  0,
-    };
-    constexpr std::array<Value, 64> KING_MATRIX = {
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -30,-40,-40,-50,-50,-40,-40,-30,
-        -20,-30,-30,-40,-40,-30,-30,-20,
-        -10,-20,-20,-20,-20,-20,-20,-10,
-        20, 20,  0,  0,  0,  0, 20, 20,
-        20, 30, 10,  0,  0, 10, 30, 20
-    };
-    // clang-format on
+    constexpr Value DOUBLED_PAWN_PENALTY = 10;
 
     /**
-     * @brief Compute the material score from white's perspective.
+     * @brief Compute the material score from white's perspective. The board
+     * keeps this score up to date, so this is only used to verify it.
      *
      * @param board
      * @return Value
@@ -108,13 +46,31 @@ namespace Brainiac {
     Value compute_material(const Board &board);
 
     /**
-     * @brief Compute the placement score from white's perspective.
+     * @brief Compute the placement score from white's perspective. The board
+     * keeps this score up to date, so this is only used to verify it.
      *
      * @param board
      * @return Value
      */
     Value compute_placement(const Board &board);
 
+    /**
+     * @brief Compute the pawn structure of a board. The scores cover passed,
+     * isolated and doubled pawns of each color.
+     *
+     * @param board
+     * @return PawnEntry
+     */
+    PawnEntry compute_pawn_structure(const Board &board);
+
+    /**
+     * @brief Evaluate a checkmated position for the current turn.
+     *
+     * @param pos
+     * @return Value
+     */
+    Value evaluate_checkmate(const Position &pos);
+
     /**
      * @brief Evaluate a position for the current turn.
      *
@@ -122,4 +78,46 @@ namespace Brainiac {
      * @return Value
      */
     Value evaluate(Position &pos);
+
+    /**
+     * @brief Evaluate a position for the current turn, reading the pawn
+     * structure from a pawn hash table.
+     *
+     * @param pos
+     * @param ptable
+     * @return Value
+     */
+    Value evaluate(Position &pos, PawnTable &ptable);
+
+    /**
+     * @brief Evaluate a position for the current turn, reading the static
+     * evaluation from an evaluation cache and the pawn structure from a pawn
+     * hash table. Terminal positions are never cached, as draws by the
+     * halfmove clock are not part of the hash.
+     *
+     * @param pos
+     * @param ptable
+     * @param ecache
+     * @param stats Optional evaluation cache counters to update
+     * @return Value
+     */
+    Value evaluate(Position &pos,
+                   PawnTable &ptable,
+                   EvalCache &ecache,
+                   TableStats *stats = nullptr);
+
+    /**
+     * @brief Evaluate a position through the caches like `evaluate`, for
+     * callers that already ruled out checkmate and draws.
+     *
+     * @param pos
+     * @param ptable
+     * @param ecache
+     * @param stats Optional evaluation cache counters to update
+     * @return Value
+     */
+    Value evaluate_static(Position &pos,
+                          PawnTable &ptable,
+                          EvalCache &ecache,
+                          TableStats *stats = nullptr);
 } // namespace Brainiac
\ No newline at end of file
@@ -1,35 +1,10 @@
 #include "Hasher.hpp"
 
 namespace Brainiac {
-    Hasher::Hasher(unsigned seed) {
-        std::default_random_engine rng{seed};
-        std::uniform_real_distribution<double> uniform(0, UINT64_MAX);
-
-        for (unsigned i = 0; i < BITSTRING_COUNT; i++) {
-            _bitstrings[i] = uniform(rng);
-        }
-    }
-
-    Hash Hasher::bitstring(Square square, Piece piece) const {
-        return _bitstrings[square * 12 + piece];
-    }
-
-    Hash Hasher::bitstring(Square ep_dst) const {
-        return _bitstrings[64 * 12 + ep_dst];
-    }
-
-    Hash Hasher::bitstring(Color turn) const {
-        return _bitstrings[64 * 12 + 64];
-    }
-
-    Hash Hasher::bitstring(CastlingFlagSet castling) const {
-        return _bitstrings[64 * 12 + 64 + 1 + castling];
-    }
-
-    Hash Hasher::operator()(Board &board,
-                            CastlingFlagSet castling,
-                            Color turn,
-                            Square ep_dst) const {
+    Hash compute_hash(const Board &board,
+                      CastlingFlagSet castling,
+                      Color turn,
+                      Square ep_dst) {
         Hash hash = 0;
         if (turn == Color::Black) {
             hash ^= bitstring(turn);
@@ -47,4 +22,29 @@ namespace Brainiac {
         hash ^= bitstring(castling);
         return hash;
     }
+
+    Hash compute_pawn_hash(const Board &board) {
+        Hash hash = 0;
+        for (Piece piece : {Piece::WhitePawn, Piece::BlackPawn}) {
+            Bitboard pawns = board.bitboard(piece);
+            while (pawns) {
+                Square square = find_lsb_bitboard(pawns);
+                hash ^= bitstring(square, piece);
+                pawns = pop_lsb_bitboard(pawns);
+            }
+        }
+        return hash;
+    }
+
+    Hash compute_material_hash(const Board &board) {
+        Hash hash = 0;
+        for (unsigned i = 0; i < 12; i++) {
+            Piece piece = static_cast<Piece>(i);
+            unsigned count = count_set_bitboard(board.bitboard(piece));
+            for (unsigned n = 0; n < count; n++) {
+                hash ^= material_bitstring(piece, n);
+            }
+        }
+        return hash;
+    }
 } // namespace Brainiac
\ No newline at end of file
@@ -1,8 +1,7 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <random>
-#include <vector>
 
 #include "Board.hpp"
 #include "Move.hpp"
@@ -22,68 +21,124 @@ namespace Brainiac {
      * 16 castling flag permutations.
      *
      */
-    const unsigned BITSTRING_COUNT = (64 * 13) + 1 + 16;
+    constexpr unsigned BITSTRING_COUNT = (64 * 13) + 1 + 16;
 
     /**
-     * @brief Zobrist hasher functor.
+     * @brief Seed of the Zobrist bitstrings.
+     *
+     * The bitstrings are generated at compile time, so hashes are identical
+     * across runs and threads. Changing the seed invalidates saved
+     * transposition tables.
      *
      */
-    class Hasher {
-        std::array<Hash, BITSTRING_COUNT> _bitstrings;
+    constexpr uint64_t ZOBRIST_SEED = 0x9E3779B97F4A7C15;
 
-      public:
-        /**
-         * @brief Initialize the hasher with a random seed.
-         *
-         * @param seed
-         */
-        Hasher(unsigned seed = time(0));
+    /**
+     * @brief Generate the Zobrist bitstrings with the SplitMix64 generator,
+     * which gives well distributed values in all 64 bits.
+     *
+     * @param seed
+     * @return std::array<Hash, BITSTRING_COUNT>
+     */
+    constexpr std::array<Hash, BITSTRING_COUNT> generate_bitstrings(Hash seed) {
+        std::array<Hash, BITSTRING_COUNT> bitstrings{};
+        Hash state = seed;
+        for (Hash &bitstring : bitstrings) {
+            Hash z = (state += 0x9E3779B97F4A7C15);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            bitstring = z ^ (z >> 31);
+        }
+        return bitstrings;
+    }
 
-        /**
-         * @brief Get the bitstring for a square / piece combination.
-         *
-         * @param square
-         * @param piece
-         * @return Hash
-         */
-        Hash bitstring(Square square, Piece piece) const;
+    /**
+     * @brief Zobrist bitstrings shared by all positions.
+     *
+     */
+    constexpr std::array<Hash, BITSTRING_COUNT> BITSTRINGS =
+        generate_bitstrings(ZOBRIST_SEED);
 
-        /**
-         * @brief Get the bitstring for an en passant target square.
-         *
-         * @param ep_dst
-         * @return Hash
-         */
-        Hash bitstring(Square ep_dst) const;
+    /**
+     * @brief Get the bitstring for a square / piece combination.
+     *
+     * @param square
+     * @param piece
+     * @return Hash
+     */
+    constexpr Hash bitstring(Square square, Piece piece) {
+        return BITSTRINGS[square * 12 + piece];
+    }
 
-        /**
-         * @brief Get the bitstring for the current color turn.
-         *
-         * @param turn
-         * @return Hash
-         */
-        Hash bitstring(Color turn) const;
+    /**
+     * @brief Get the bitstring for an en passant target square.
+     *
+     * @param ep_dst
+     * @return Hash
+     */
+    constexpr Hash bitstring(Square ep_dst) {
+        return BITSTRINGS[64 * 12 + ep_dst];
+    }
 
-        /**
-         * @brief Get the bitstring for a castling rights bitfield.
-         *
-         * @param castling
-         * @return Hash
-         */
-        Hash bitstring(CastlingFlagSet castling) const;
+    /**
+     * @brief Get the bitstring for the current color turn.
+     *
+     * @param turn
+     * @return Hash
+     */
+    constexpr Hash bitstring(Color turn) { return BITSTRINGS[64 * 12 + 64]; }
 
-        /**
-         * @brief State hashing function.
-         *
-         * @param board
-         * @param castling
-         * @param turn
-         * @param ep_dst
-         * @return Hash
-         */
-        Hash operator()(Board &board,
-                        CastlingFlagSet castling,
-                        Color turn,
-                        Square ep_dst) const;
-    };
+    /**
+     * @brief Get the bitstring for a castling rights bitfield.
+     *
+     * @param castling
+     * @return Hash
+     */
+    constexpr Hash bitstring(CastlingFlagSet castling) {
+        return BITSTRINGS[64 * 12 + 64 + 1 + castling];
+    }
+
+    /**
+     * @brief Get the material bitstring for the n-th piece of a kind, counting
+     * from 0. The piece-square bitstrings are reused, with the count in place
+     * of the square, so a material key is the XOR over each piece kind of the
+     * bitstrings for counts [0, count).
+     *
+     * @param piece
+     * @param count
+     * @return Hash
+     */
+    constexpr Hash material_bitstring(Piece piece, unsigned count) {
+        return BITSTRINGS[count * 12 + piece];
+    }
+
+    /**
+     * @brief Compute the hash of a state from scratch.
+     *
+     * @param board
+     * @param castling
+     * @param turn
+     * @param ep_dst
+     * @return Hash
+     */
+    Hash compute_hash(const Board &board,
+                      CastlingFlagSet castling,
+                      Color turn,
+                      Square ep_dst);
+
+    /**
+     * @brief Compute the pawn structure hash of a board from scratch.
+     *
+     * @param board
+     * @return Hash
+     */
+    Hash compute_pawn_hash(const Board &board);
+
+    /**
+     * @brief Compute the material signature hash of a board from scratch.
+     *
+     * @param board
+     * @return Hash
+     */
+    Hash compute_material_hash(const Board &board);
 } // namespace Brainiac
\ No newline at end of file
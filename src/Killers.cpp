@@ -0,0 +1,23 @@
+#include "Killers.hpp"
+
+namespace Brainiac {
+    Killers::Killers() { clear(); }
+
+    Move Killers::get(Depth ply, unsigned slot) const {
+        return _table[ply][slot];
+    }
+
+    void Killers::set(Depth ply, Move move) {
+        std::array<Move, KILLERS_PER_PLY> &killers = _table[ply];
+        if (killers[0] == move) return;
+
+        std::copy_backward(killers.begin(), killers.end() - 1, killers.end());
+        killers[0] = move;
+    }
+
+    void Killers::clear() {
+        for (std::array<Move, KILLERS_PER_PLY> &killers : _table) {
+            killers.fill(Move());
+        }
+    }
+} // namespace Brainiac
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "Move.hpp"
+#include "Numeric.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Number of killer moves kept per ply.
+     *
+     */
+    constexpr unsigned KILLERS_PER_PLY = 2;
+
+    /**
+     * @brief Killer move table for move ordering. Stores the most recent quiet
+     * moves that caused a beta cutoff at each ply.
+     *
+     */
+    class Killers {
+        std::array<std::array<Move, KILLERS_PER_PLY>, MAX_DEPTH> _table;
+
+      public:
+        Killers();
+
+        /**
+         * @brief Get a killer move at a ply.
+         *
+         * @param ply
+         * @param slot
+         * @return Move
+         */
+        Move get(Depth ply, unsigned slot) const;
+
+        /**
+         * @brief Record a killer move at a ply, evicting the oldest one.
+         *
+         * @param ply
+         * @param move
+         */
+        void set(Depth ply, Move move);
+
+        /**
+         * @brief Clear the table.
+         *
+         */
+        void clear();
+    };
+} // namespace Brainiac
\ No newline at end of file
@@ -3,7 +3,6 @@
 namespace Brainiac {
     Move::Move(Square src, Square dst, MoveType flags) :
         _bitfield(dst | (src << 6) | (flags << 12)){};
-    Move::Move() : _bitfield(0){};
 
     Square Move::src() const { return Square((_bitfield >> 6) & 0x3F); }
 
@@ -64,7 +64,13 @@ namespace Brainiac {
          * @param type
          */
         Move(Square src, Square dst, MoveType type);
-        Move();
+
+        /**
+         * @brief Create a null move. This is inline so that move lists and
+         * state stacks can be filled without a call per entry.
+         *
+         */
+        constexpr Move() : _bitfield(0) {}
 
         /**
          * @brief Get the starting square of this move.
@@ -17,46 +17,48 @@ namespace Brainiac {
 
     Bitboard knight_attacks(Square sq) { return KNIGHT_MOVE_MASKS[sq]; }
 
-    Bitboard rook_attacks(Square sq, Bitboard friends, Bitboard enemies) {
-        const SlidingMoveTable &table = ROOK_ATTACK_TABLES[sq];
-        Bitboard blockers = table.block_mask & (friends | enemies);
-        Bitboard index = (blockers * table.magic) >> (64 - table.shift);
-
-        return table.move_masks[index] & ~friends;
-    }
-
-    Bitboard bishop_attacks(Square sq, Bitboard friends, Bitboard enemies) {
-        const SlidingMoveTable &table = BISHOP_ATTACK_TABLES[sq];
-        Bitboard blockers = table.block_mask & (friends | enemies);
-        Bitboard index = (blockers * table.magic) >> (64 - table.shift);
-
-        return table.move_masks[index] & ~friends;
+    bool is_attacked(Square sq,
+                     Color turn,
+                     Bitboard all,
+                     Bitboard o_pawn,
+                     Bitboard o_knight,
+                     Bitboard o_bishop,
+                     Bitboard o_rook,
+                     Bitboard o_queen) {
+        Bitboard hv = rook_attacks(sq, 0, all) & (o_rook | o_queen);
+        Bitboard d12 = bishop_attacks(sq, 0, all) & (o_bishop | o_queen);
+        Bitboard leapers = (pawn_captures(sq, turn) & o_pawn) |
+                           (knight_attacks(sq) & o_knight);
+        return hv | d12 | leapers;
     }
 
-    Bitboard queen_attacks(Square sq, Bitboard friends, Bitboard enemies) {
-        Bitboard all = friends | enemies;
-
-        const SlidingMoveTable &r_table = ROOK_ATTACK_TABLES[sq];
-        unsigned r_shift = 64 - r_table.shift;
-        Bitboard r_blockers = r_table.block_mask & all;
-        Bitboard r_index = (r_blockers * r_table.magic) >> r_shift;
-
-        const SlidingMoveTable &b_table = BISHOP_ATTACK_TABLES[sq];
-        unsigned b_shift = 64 - b_table.shift;
-        Bitboard b_blockers = b_table.block_mask & all;
-        Bitboard b_index = (b_blockers * b_table.magic) >> b_shift;
-
-        return (r_table.move_masks[r_index] | b_table.move_masks[b_index]) &
-               ~friends;
+    /**
+     * @brief Get the full rank, file or diagonal passing through two aligned
+     * squares.
+     *
+     * @param a
+     * @param b
+     * @return Bitboard
+     */
+    static Bitboard line_through(Square a, Square b) {
+        Bitboard b_mask = SQUARES[b];
+        if (SQUARE_RANKS[a] & b_mask) return SQUARE_RANKS[a];
+        if (SQUARE_FILES[a] & b_mask) return SQUARE_FILES[a];
+        if (SQUARE_DIAGONALS[a] & b_mask) return SQUARE_DIAGONALS[a];
+        return SQUARE_ANTI_DIAGONALS[a];
     }
 
+    template <Color C>
     void MoveGen::compute_attackmask() {
-        Color op = static_cast<Color>(!turn);
         Square king_sq = find_lsb_bitboard(o_king);
         o_king_attacks = king_attacks(king_sq);
-        o_pawn_attacks =
-            (((o_pawn << 7) & ~FILES[7]) | ((o_pawn << 9) & ~FILES[0])) >>
-            (op << 4);
+        if constexpr (C == Color::White) {
+            o_pawn_attacks =
+                ((o_pawn >> 9) & ~FILES[7]) | ((o_pawn >> 7) & ~FILES[0]);
+        } else {
+            o_pawn_attacks =
+                ((o_pawn << 7) & ~FILES[7]) | ((o_pawn << 9) & ~FILES[0]);
+        }
 
         o_knight_attacks = 0;
         Bitboard knights = o_knight;
@@ -112,6 +114,7 @@ namespace Brainiac {
         check = attackmask & f_king;
     }
 
+    template <Color C>
     void MoveGen::compute_checkmask() {
         checkmask = -1;
         if (check) {
@@ -132,7 +135,7 @@ namespace Brainiac {
                 o_bishop | o_bishop_d2_attacks | o_queen | o_queen_d2_attacks;
             checkmask =
                 // Pawn
-                (pawn_captures(sq, turn) & o_pawn) |
+                (pawn_captures<C>(sq) & o_pawn) |
                 // Knight
                 (knight_attacks(sq) & o_knight) |
                 // HV sliders
@@ -188,6 +191,77 @@ namespace Brainiac {
         pinmask = pinmask_hv | pinmask_d12;
     }
 
+    template <Color C>
+    void MoveGen::compute_checksquares() {
+        constexpr Color op = static_cast<Color>(!C);
+        o_king_sq = find_lsb_bitboard(o_king);
+
+        Bitboard rook_checks = rook_attacks(o_king_sq, 0, all);
+        Bitboard bishop_checks = bishop_attacks(o_king_sq, 0, all);
+        check_squares[PieceType::King] = 0;
+        check_squares[PieceType::Pawn] = pawn_captures<op>(o_king_sq);
+        check_squares[PieceType::Rook] = rook_checks;
+        check_squares[PieceType::Knight] = knight_attacks(o_king_sq);
+        check_squares[PieceType::Bishop] = bishop_checks;
+        check_squares[PieceType::Queen] = rook_checks | bishop_checks;
+
+        // Friendly pieces standing alone between a friendly slider and the
+        // opponent king discover check when they step off the line
+        discover_blockers = 0;
+        Bitboard snipers =
+            (rook_attacks(o_king_sq, 0, 0) & (f_rook | f_queen)) |
+            (bishop_attacks(o_king_sq, 0, 0) & (f_bishop | f_queen));
+        while (snipers) {
+            Square sq = find_lsb_bitboard(snipers);
+            Bitboard line = line_through(o_king_sq, sq);
+            Bitboard between = queen_attacks(o_king_sq, 0, all) &
+                               queen_attacks(sq, 0, all) & line;
+            Bitboard blockers = between & all;
+            if (blockers && !pop_lsb_bitboard(blockers)) {
+                discover_blockers |= blockers & friends;
+            }
+            snipers = pop_lsb_bitboard(snipers);
+        }
+        checks_ready = true;
+    }
+
+    void MoveGen::load_checksquares() {
+        if (checks_ready) return;
+        if (turn == Color::White) {
+            compute_checksquares<Color::White>();
+        } else {
+            compute_checksquares<Color::Black>();
+        }
+    }
+
+    template <GenType G>
+    Bitboard MoveGen::quiet_targets(Square src_sq,
+                                    PieceType type,
+                                    Bitboard targets) const {
+        if constexpr (G != GenType::GenQuietChecks) {
+            return targets;
+        } else {
+            Bitboard checks = check_squares[type];
+            if (discover_blockers & SQUARES[src_sq]) {
+                checks |= ~line_through(o_king_sq, src_sq);
+            }
+            return targets & checks;
+        }
+    }
+
+    bool MoveGen::castle_checks(Square king_src,
+                                Square king_dst,
+                                Square rook_src,
+                                Square rook_dst) const {
+        Bitboard occupied = (all & ~SQUARES[king_src] & ~SQUARES[rook_src]) |
+                            SQUARES[king_dst] | SQUARES[rook_dst];
+        if (rook_attacks(rook_dst, 0, occupied) & o_king) return true;
+        return quiet_targets<GenType::GenQuietChecks>(king_src,
+                                                      PieceType::King,
+                                                      SQUARES[king_dst]);
+    }
+
+    template <Color C, GenType G>
     void MoveGen::generate_king_moves(MoveList &moves) {
         Bitboard danger = o_pawn_attacks | o_knight_attacks | o_king_attacks;
         Bitboard no_king = all & ~f_king;
@@ -217,48 +291,68 @@ namespace Brainiac {
         Bitboard targets = king_attacks(src_sq) & ~(friends | danger);
 
         // King quiet
-        Bitboard quiet = targets & ~enemies;
-        while (quiet) {
-            Square dst_sq = find_lsb_bitboard(quiet);
-            moves.add(src_sq, dst_sq, MoveType::Quiet);
-            quiet = pop_lsb_bitboard(quiet);
+        if constexpr (has_quiets(G)) {
+            Bitboard quiet = quiet_targets<G>(src_sq,
+                                              PieceType::King,
+                                              targets & ~enemies);
+            while (quiet) {
+                Square dst_sq = find_lsb_bitboard(quiet);
+                moves.add(src_sq, dst_sq, MoveType::Quiet);
+                quiet = pop_lsb_bitboard(quiet);
+            }
         }
 
         // King captures
-        Bitboard captures = targets & enemies;
-        while (captures) {
-            Square dst_sq = find_lsb_bitboard(captures);
-            moves.add(src_sq, dst_sq, MoveType::Capture);
-            captures = pop_lsb_bitboard(captures);
+        if constexpr (has_noisy(G)) {
+            Bitboard captures = targets & enemies;
+            while (captures) {
+                Square dst_sq = find_lsb_bitboard(captures);
+                moves.add(src_sq, dst_sq, MoveType::Capture);
+                captures = pop_lsb_bitboard(captures);
+            }
         }
 
         // King castling
-        if (!check) {
-            CastlingRight king_side = static_cast<CastlingRight>(2 * turn);
+        if (has_quiets(G) && !check) {
+            constexpr CastlingRight king_side =
+                static_cast<CastlingRight>(2 * C);
             if (castling & (1 << king_side)) {
-                Bitboard king_pass = CASTLING_MASKS[king_side];
+                constexpr Bitboard king_pass = CASTLING_MASKS[king_side];
                 if (!(king_pass & attackmask) && !(king_pass & all)) {
                     Square dst_sq = static_cast<Square>(src_sq + 2);
-                    moves.add(src_sq, dst_sq, MoveType::KingCastle);
+                    Square rook_sq = static_cast<Square>(src_sq + 3);
+                    Square rook_dst_sq = static_cast<Square>(dst_sq - 1);
+                    if (G != GenType::GenQuietChecks ||
+                        castle_checks(src_sq, dst_sq, rook_sq, rook_dst_sq)) {
+                        moves.add(src_sq, dst_sq, MoveType::KingCastle);
+                    }
                 }
             }
 
-            CastlingRight queen_side = static_cast<CastlingRight>(2 * turn + 1);
+            constexpr CastlingRight queen_side =
+                static_cast<CastlingRight>(2 * C + 1);
             if ((castling & (1 << queen_side))) {
-                Bitboard queen_pass = CASTLING_MASKS[queen_side];
+                constexpr Bitboard queen_pass = CASTLING_MASKS[queen_side];
                 if (!(queen_pass & ~FILES[1] & attackmask) &&
                     !(queen_pass & all)) {
                     Square dst_sq = static_cast<Square>(src_sq - 2);
-                    moves.add(src_sq, dst_sq, MoveType::QueenCastle);
+                    Square rook_sq = static_cast<Square>(src_sq - 4);
+                    Square rook_dst_sq = static_cast<Square>(dst_sq + 1);
+                    if (G != GenType::GenQuietChecks ||
+                        castle_checks(src_sq, dst_sq, rook_sq, rook_dst_sq)) {
+                        moves.add(src_sq, dst_sq, MoveType::QueenCastle);
+                    }
                 }
             }
         }
     }
 
+    template <Color C, GenType G>
     void MoveGen::generate_pawn_moves(MoveList &moves) {
         Square king_sq = find_lsb_bitboard(f_king);
         Bitboard ep_target = SQUARES[ep_dst];
-        Bitboard ep_capture = (ep_target << 8) >> (!turn << 4);
+        Bitboard ep_capture =
+            C == Color::White ? (ep_target >> 8) : (ep_target << 8);
         Bitboard ep_condition = ep_capture & checkmask;
         Bitboard horizon_mask = (o_queen | o_rook) & SQUARE_RANKS[king_sq];
 
@@ -266,35 +360,45 @@ namespace Brainiac {
         Bitboard pawns = f_pawn & ~pinmask;
         while (pawns) {
             Square src_sq = find_lsb_bitboard(pawns);
-            Bitboard advances = pawn_advances(src_sq, turn) & ~all;
-            Bitboard doubles = pawn_doubles(src_sq, turn) & ~all;
-            Bitboard captures = pawn_captures(src_sq, turn);
+            Bitboard advances = pawn_advances<C>(src_sq) & ~all;
+            Bitboard doubles = pawn_doubles<C>(src_sq) & ~all;
+            Bitboard captures = pawn_captures<C>(src_sq);
 
             // Pawn advances with promotions
             Bitboard advances_checkmask = advances & checkmask;
             Bitboard advances_only = advances_checkmask & ~PROMOTION_MASK;
             Bitboard advances_promote = advances_checkmask & PROMOTION_MASK;
-            while (advances_only) {
-                Square dst_sq = find_lsb_bitboard(advances_only);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                advances_only = pop_lsb_bitboard(advances_only);
+            if constexpr (has_quiets(G)) {
+                advances_only =
+                    quiet_targets<G>(src_sq, PieceType::Pawn, advances_only);
+                while (advances_only) {
+                    Square dst_sq = find_lsb_bitboard(advances_only);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    advances_only = pop_lsb_bitboard(advances_only);
+                }
             }
-            while (advances_promote) {
-                Square dst_sq = find_lsb_bitboard(advances_promote);
-                moves.add(src_sq, dst_sq, MoveType::KnightPromo);
-                moves.add(src_sq, dst_sq, MoveType::RookPromo);
-                moves.add(src_sq, dst_sq, MoveType::BishopPromo);
-                moves.add(src_sq, dst_sq, MoveType::QueenPromo);
-                advances_promote = pop_lsb_bitboard(advances_promote);
+            if constexpr (has_noisy(G)) {
+                while (advances_promote) {
+                    Square dst_sq = find_lsb_bitboard(advances_promote);
+                    moves.add(src_sq, dst_sq, MoveType::KnightPromo);
+                    moves.add(src_sq, dst_sq, MoveType::RookPromo);
+                    moves.add(src_sq, dst_sq, MoveType::BishopPromo);
+                    moves.add(src_sq, dst_sq, MoveType::QueenPromo);
+                    advances_promote = pop_lsb_bitboard(advances_promote);
+                }
             }
 
             // Pawn double advance
             Bitboard double_mask = -static_cast<bool>(advances) & checkmask;
-            Bitboard doubles_only = doubles & double_mask;
-            while (doubles_only) {
-                Square dst_sq = find_lsb_bitboard(doubles_only);
-                moves.add(src_sq, dst_sq, MoveType::PawnDouble);
-                doubles_only = pop_lsb_bitboard(doubles_only);
+            if constexpr (has_quiets(G)) {
+                Bitboard doubles_only = doubles & double_mask;
+                doubles_only =
+                    quiet_targets<G>(src_sq, PieceType::Pawn, doubles_only);
+                while (doubles_only) {
+                    Square dst_sq = find_lsb_bitboard(doubles_only);
+                    moves.add(src_sq, dst_sq, MoveType::PawnDouble);
+                    doubles_only = pop_lsb_bitboard(doubles_only);
+                }
             }
 
             // Pawn captures with promotions and en-passant
@@ -302,20 +406,22 @@ namespace Brainiac {
             Bitboard captures_only = captures_checkmask & ~PROMOTION_MASK;
             Bitboard captures_promote = captures_checkmask & PROMOTION_MASK;
             Bitboard captures_ep = captures & ep_target;
-            while (captures_only) {
-                Square dst_sq = find_lsb_bitboard(captures_only);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures_only = pop_lsb_bitboard(captures_only);
-            }
-            while (captures_promote) {
-                Square dst_sq = find_lsb_bitboard(captures_promote);
-                moves.add(src_sq, dst_sq, MoveType::KnightPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::RookPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::BishopPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::QueenPromoCapture);
-                captures_promote = pop_lsb_bitboard(captures_promote);
+            if constexpr (has_noisy(G)) {
+                while (captures_only) {
+                    Square dst_sq = find_lsb_bitboard(captures_only);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures_only = pop_lsb_bitboard(captures_only);
+                }
+                while (captures_promote) {
+                    Square dst_sq = find_lsb_bitboard(captures_promote);
+                    moves.add(src_sq, dst_sq, MoveType::KnightPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::RookPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::BishopPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::QueenPromoCapture);
+                    captures_promote = pop_lsb_bitboard(captures_promote);
+                }
             }
-            if (captures_ep && ep_condition) {
+            if (has_noisy(G) && captures_ep && ep_condition) {
                 Bitboard horizon_check =
                     rook_attacks(king_sq,
                                  friends & ~(1ULL << src_sq),
@@ -335,35 +441,45 @@ namespace Brainiac {
         Bitboard pawns_hv = f_pawn & pinmask_hv;
         while (pawns_hv) {
             Square src_sq = find_lsb_bitboard(pawns_hv);
-            Bitboard advances = pawn_advances(src_sq, turn) & ~all;
-            Bitboard doubles = pawn_doubles(src_sq, turn) & ~all;
+            Bitboard advances = pawn_advances<C>(src_sq) & ~all;
+            Bitboard doubles = pawn_doubles<C>(src_sq) & ~all;
 
             // Pawn advances with promotions
             Bitboard advances_checkmask = advances & check_pinned_hv;
             Bitboard advances_only = advances_checkmask & ~PROMOTION_MASK;
             Bitboard advances_promote = advances_checkmask & PROMOTION_MASK;
-            while (advances_only) {
-                Square dst_sq = find_lsb_bitboard(advances_only);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                advances_only = pop_lsb_bitboard(advances_only);
+            if constexpr (has_quiets(G)) {
+                advances_only =
+                    quiet_targets<G>(src_sq, PieceType::Pawn, advances_only);
+                while (advances_only) {
+                    Square dst_sq = find_lsb_bitboard(advances_only);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    advances_only = pop_lsb_bitboard(advances_only);
+                }
             }
-            while (advances_promote) {
-                Square dst_sq = find_lsb_bitboard(advances_promote);
-                moves.add(src_sq, dst_sq, MoveType::KnightPromo);
-                moves.add(src_sq, dst_sq, MoveType::RookPromo);
-                moves.add(src_sq, dst_sq, MoveType::BishopPromo);
-                moves.add(src_sq, dst_sq, MoveType::QueenPromo);
-                advances_promote = pop_lsb_bitboard(advances_promote);
+            if constexpr (has_noisy(G)) {
+                while (advances_promote) {
+                    Square dst_sq = find_lsb_bitboard(advances_promote);
+                    moves.add(src_sq, dst_sq, MoveType::KnightPromo);
+                    moves.add(src_sq, dst_sq, MoveType::RookPromo);
+                    moves.add(src_sq, dst_sq, MoveType::BishopPromo);
+                    moves.add(src_sq, dst_sq, MoveType::QueenPromo);
+                    advances_promote = pop_lsb_bitboard(advances_promote);
+                }
             }
 
             // Pawn double advance
             Bitboard double_mask =
                 -static_cast<bool>(advances) & check_pinned_hv;
-            Bitboard doubles_only = doubles & double_mask;
-            while (doubles_only) {
-                Square dst_sq = find_lsb_bitboard(doubles_only);
-                moves.add(src_sq, dst_sq, MoveType::PawnDouble);
-                doubles_only = pop_lsb_bitboard(doubles_only);
+            if constexpr (has_quiets(G)) {
+                Bitboard doubles_only = doubles & double_mask;
+                doubles_only =
+                    quiet_targets<G>(src_sq, PieceType::Pawn, doubles_only);
+                while (doubles_only) {
+                    Square dst_sq = find_lsb_bitboard(doubles_only);
+                    moves.add(src_sq, dst_sq, MoveType::PawnDouble);
+                    doubles_only = pop_lsb_bitboard(doubles_only);
+                }
             }
 
             pawns_hv = pop_lsb_bitboard(pawns_hv);
@@ -373,7 +489,7 @@ namespace Brainiac {
         Bitboard pawns_d12 = f_pawn & pinmask_d12;
         while (pawns_d12) {
             Square src_sq = find_lsb_bitboard(pawns_d12);
-            Bitboard captures = pawn_captures(src_sq, turn);
+            Bitboard captures = pawn_captures<C>(src_sq);
 
             // Pawn captures with promotions and en-passant
             Bitboard captures_checkmask =
@@ -381,20 +497,22 @@ namespace Brainiac {
             Bitboard captures_only = captures_checkmask & ~PROMOTION_MASK;
             Bitboard captures_promote = captures_checkmask & PROMOTION_MASK;
             Bitboard captures_ep = captures & ep_target & pinmask_d12;
-            while (captures_only) {
-                Square dst_sq = find_lsb_bitboard(captures_only);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures_only = pop_lsb_bitboard(captures_only);
-            }
-            while (captures_promote) {
-                Square dst_sq = find_lsb_bitboard(captures_promote);
-                moves.add(src_sq, dst_sq, MoveType::KnightPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::RookPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::BishopPromoCapture);
-                moves.add(src_sq, dst_sq, MoveType::QueenPromoCapture);
-                captures_promote = pop_lsb_bitboard(captures_promote);
+            if constexpr (has_noisy(G)) {
+                while (captures_only) {
+                    Square dst_sq = find_lsb_bitboard(captures_only);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures_only = pop_lsb_bitboard(captures_only);
+                }
+                while (captures_promote) {
+                    Square dst_sq = find_lsb_bitboard(captures_promote);
+                    moves.add(src_sq, dst_sq, MoveType::KnightPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::RookPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::BishopPromoCapture);
+                    moves.add(src_sq, dst_sq, MoveType::QueenPromoCapture);
+                    captures_promote = pop_lsb_bitboard(captures_promote);
+                }
             }
-            if (captures_ep && ep_condition) {
+            if (has_noisy(G) && captures_ep && ep_condition) {
                 Bitboard horizon_check =
                     rook_attacks(king_sq,
                                  friends & ~(1ULL << src_sq),
@@ -410,6 +528,7 @@ namespace Brainiac {
         }
     }
 
+    template <GenType G>
     void MoveGen::generate_knight_moves(MoveList &moves) {
         Bitboard targetmask = ~friends & checkmask;
         Bitboard knights = f_knight & ~pinmask;
@@ -418,25 +537,32 @@ namespace Brainiac {
             Bitboard targets = knight_attacks(src_sq) & targetmask;
 
             // Knight quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Knight,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Knight captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             knights = pop_lsb_bitboard(knights);
         }
     }
 
+    template <GenType G>
     void MoveGen::generate_rook_moves(MoveList &moves) {
         // Unpinned rooks
         Bitboard rooks = f_rook & ~pinmask;
@@ -446,19 +572,25 @@ namespace Brainiac {
                 rook_attacks(src_sq, friends, enemies) & checkmask;
 
             // Rook quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Rook,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Rook captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             rooks = pop_lsb_bitboard(rooks);
@@ -473,25 +605,32 @@ namespace Brainiac {
                 rook_attacks(src_sq, friends, enemies) & targetmask_hv;
 
             // Rook quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Rook,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Rook captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             rooks_hv = pop_lsb_bitboard(rooks_hv);
         }
     }
 
+    template <GenType G>
     void MoveGen::generate_bishop_moves(MoveList &moves) {
         // Unpinned bishops
         Bitboard bishops = f_bishop & ~pinmask;
@@ -501,19 +640,25 @@ namespace Brainiac {
                 bishop_attacks(src_sq, friends, enemies) & checkmask;
 
             // Bishop quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Bishop,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Bishop captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             bishops = pop_lsb_bitboard(bishops);
@@ -528,25 +673,32 @@ namespace Brainiac {
                 bishop_attacks(src_sq, friends, enemies) & targetmask_d12;
 
             // Bishop quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Bishop,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Bishop captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             bishops_d12 = pop_lsb_bitboard(bishops_d12);
         }
     }
 
+    template <GenType G>
     void MoveGen::generate_queen_moves(MoveList &moves) {
         // Unpinned queens
         Bitboard queens = f_queen & ~pinmask;
@@ -556,19 +708,25 @@ namespace Brainiac {
                 queen_attacks(src_sq, friends, enemies) & checkmask;
 
             // Queen quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Queen,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Queen captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             queens = pop_lsb_bitboard(queens);
@@ -583,19 +741,25 @@ namespace Brainiac {
                 rook_attacks(src_sq, friends, enemies) & targetmask_hv;
 
             // Queen quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Queen,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Queen captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             queens_hv = pop_lsb_bitboard(queens_hv);
@@ -610,39 +774,308 @@ namespace Brainiac {
                 bishop_attacks(src_sq, friends, enemies) & targetmask_d12;
 
             // Queen quiet
-            Bitboard quiet = targets & ~enemies;
-            while (quiet) {
-                Square dst_sq = find_lsb_bitboard(quiet);
-                moves.add(src_sq, dst_sq, MoveType::Quiet);
-                quiet = pop_lsb_bitboard(quiet);
+            if constexpr (has_quiets(G)) {
+                Bitboard quiet = quiet_targets<G>(src_sq,
+                                                  PieceType::Queen,
+                                                  targets & ~enemies);
+                while (quiet) {
+                    Square dst_sq = find_lsb_bitboard(quiet);
+                    moves.add(src_sq, dst_sq, MoveType::Quiet);
+                    quiet = pop_lsb_bitboard(quiet);
+                }
             }
 
             // Queen captures
-            Bitboard captures = targets & enemies;
-            while (captures) {
-                Square dst_sq = find_lsb_bitboard(captures);
-                moves.add(src_sq, dst_sq, MoveType::Capture);
-                captures = pop_lsb_bitboard(captures);
+            if constexpr (has_noisy(G)) {
+                Bitboard captures = targets & enemies;
+                while (captures) {
+                    Square dst_sq = find_lsb_bitboard(captures);
+                    moves.add(src_sq, dst_sq, MoveType::Capture);
+                    captures = pop_lsb_bitboard(captures);
+                }
             }
 
             queens_d12 = pop_lsb_bitboard(queens_d12);
         }
     }
 
-    bool MoveGen::generate(MoveList &moves) {
-        compute_attackmask();
-        compute_checkmask();
+    void MoveGen::prepare() {
+        if (turn == Color::White) {
+            prepare<Color::White>();
+        } else {
+            prepare<Color::Black>();
+        }
+    }
+
+    template <Color C>
+    void MoveGen::prepare() {
+        compute_attackmask<C>();
+        compute_checkmask<C>();
         compute_pinmasks();
+        checks_ready = false;
+    }
+
+    template <GenType G>
+    bool MoveGen::generate(MoveList &moves) {
+        prepare();
+        return generate_prepared<G>(moves);
+    }
 
+    template <GenType G>
+    bool MoveGen::generate_prepared(MoveList &moves) {
+        // Dispatch on the turn once, so the color is constant below
+        if (turn == Color::White) {
+            generate_color<Color::White, G>(moves);
+        } else {
+            generate_color<Color::Black, G>(moves);
+        }
+        return check;
+    }
+
+    template <Color C, GenType G>
+    void MoveGen::generate_color(MoveList &moves) {
+        // Evasions are only defined while in check
+        if constexpr (G == GenType::GenEvasions) {
+            if (!check) return;
+        }
+        if constexpr (G == GenType::GenQuietChecks) {
+            if (!checks_ready) compute_checksquares<C>();
+        }
+
+        generate_king_moves<C, G>(moves);
+        generate_pieces<C, G>(moves);
+    }
+
+    bool MoveGen::generate_king(MoveList &moves) {
+        if (turn == Color::White) {
+            generate_king_moves<Color::White, GenType::GenAll>(moves);
+        } else {
+            generate_king_moves<Color::Black, GenType::GenAll>(moves);
+        }
+        return check;
+    }
+
+    void MoveGen::generate_others(MoveList &moves) {
+        if (turn == Color::White) {
+            generate_pieces<Color::White, GenType::GenAll>(moves);
+        } else {
+            generate_pieces<Color::Black, GenType::GenAll>(moves);
+        }
+    }
+
+    template <Color C, GenType G>
+    void MoveGen::generate_pieces(MoveList &moves) {
         // Only generate the remaining moves if not double-checked
-        generate_king_moves(moves);
         if (!check || count_set_bitboard(checkmask & enemies) < 2) {
-            generate_pawn_moves(moves);
-            generate_rook_moves(moves);
-            generate_knight_moves(moves);
-            generate_bishop_moves(moves);
-            generate_queen_moves(moves);
+            generate_pawn_moves<C, G>(moves);
+            generate_rook_moves<G>(moves);
+            generate_knight_moves<G>(moves);
+            generate_bishop_moves<G>(moves);
+            generate_queen_moves<G>(moves);
         }
-        return check;
     }
+
+    bool MoveGen::is_pseudo_legal(Move move) const {
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        MoveType type = move.type();
+        Bitboard src = SQUARES[src_sq];
+        Bitboard dst = SQUARES[dst_sq];
+        if (type == MoveType::Skip || !(friends & src)) return false;
+
+        // The destination must match the kind of move
+        bool promotion = type >= MoveType::KnightPromo;
+        bool capture = type == MoveType::Capture ||
+                       type >= MoveType::KnightPromoCapture;
+        if (type == MoveType::EnPassant) {
+            if (dst_sq != ep_dst) return false;
+        } else if (capture) {
+            if (!(enemies & ~o_king & dst)) return false;
+        } else if (all & dst) {
+            return false;
+        }
+
+        if (f_pawn & src) {
+            if (promotion != static_cast<bool>(dst & PROMOTION_MASK)) {
+                return false;
+            }
+            switch (type) {
+            case MoveType::PawnDouble:
+                return (pawn_advances(src_sq, turn) & ~all) &&
+                       (pawn_doubles(src_sq, turn) & dst);
+            case MoveType::Capture:
+            case MoveType::EnPassant:
+                return pawn_captures(src_sq, turn) & dst;
+            default:
+                if (capture) return pawn_captures(src_sq, turn) & dst;
+                return type != MoveType::KingCastle &&
+                       type != MoveType::QueenCastle &&
+                       (pawn_advances(src_sq, turn) & dst);
+            }
+        }
+        if (promotion || type == MoveType::PawnDouble ||
+            type == MoveType::EnPassant) {
+            return false;
+        }
+
+        if (f_king & src) {
+            if (type == MoveType::KingCastle) {
+                CastlingRight side = static_cast<CastlingRight>(2 * turn);
+                return (castling & (1 << side)) && dst_sq == src_sq + 2 &&
+                       !(CASTLING_MASKS[side] & all);
+            }
+            if (type == MoveType::QueenCastle) {
+                CastlingRight side = static_cast<CastlingRight>(2 * turn + 1);
+                return (castling & (1 << side)) && dst_sq == src_sq - 2 &&
+                       !(CASTLING_MASKS[side] & all);
+            }
+            return king_attacks(src_sq) & dst;
+        }
+        if (type == MoveType::KingCastle || type == MoveType::QueenCastle) {
+            return false;
+        }
+
+        Bitboard targets;
+        if (f_knight & src) {
+            targets = knight_attacks(src_sq);
+        } else if (f_bishop & src) {
+            targets = bishop_attacks(src_sq, friends, enemies);
+        } else if (f_rook & src) {
+            targets = rook_attacks(src_sq, friends, enemies);
+        } else {
+            targets = queen_attacks(src_sq, friends, enemies);
+        }
+        return targets & dst;
+    }
+
+    bool MoveGen::is_legal(Move move) const {
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        MoveType type = move.type();
+        Bitboard src = SQUARES[src_sq];
+        Bitboard dst = SQUARES[dst_sq];
+        Square king_sq = find_lsb_bitboard(f_king);
+
+        if (f_king & src) {
+            if (type == MoveType::KingCastle) {
+                CastlingRight side = static_cast<CastlingRight>(2 * turn);
+                return !check && !(CASTLING_MASKS[side] & attackmask);
+            }
+            if (type == MoveType::QueenCastle) {
+                CastlingRight side = static_cast<CastlingRight>(2 * turn + 1);
+                return !check &&
+                       !(CASTLING_MASKS[side] & ~FILES[1] & attackmask);
+            }
+
+            // Sliders must see through the king's current square
+            if (o_king_attacks & dst) return false;
+            return !is_attacked(dst_sq,
+                                turn,
+                                all & ~f_king,
+                                o_pawn,
+                                o_knight,
+                                o_bishop,
+                                o_rook,
+                                o_queen);
+        }
+
+        // Only the king can move out of a double check
+        if (check && count_set_bitboard(checkmask & enemies) >= 2) {
+            return false;
+        }
+
+        // En-passant removes two pieces from the king's lines
+        if (type == MoveType::EnPassant) {
+            Bitboard victim = turn == Color::White ? (dst >> 8) : (dst << 8);
+            Bitboard occupied = (all & ~src & ~victim) | dst;
+            return !is_attacked(king_sq,
+                                turn,
+                                occupied,
+                                o_pawn & ~victim,
+                                o_knight,
+                                o_bishop,
+                                o_rook,
+                                o_queen);
+        }
+
+        if (!(checkmask & dst)) return false;
+        if (pinmask & src) return line_through(king_sq, src_sq) & dst;
+        return true;
+    }
+
+    bool MoveGen::gives_check(Move move) {
+        load_checksquares();
+
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        MoveType type = move.type();
+        Bitboard src = SQUARES[src_sq];
+        Bitboard dst = SQUARES[dst_sq];
+
+        // Stepping off the line between a slider and the opponent king
+        if ((discover_blockers & src) &&
+            !(line_through(o_king_sq, src_sq) & dst)) {
+            return true;
+        }
+
+        switch (type) {
+        case MoveType::KingCastle:
+            return castle_checks(src_sq,
+                                 dst_sq,
+                                 static_cast<Square>(src_sq + 3),
+                                 static_cast<Square>(dst_sq - 1));
+        case MoveType::QueenCastle:
+            return castle_checks(src_sq,
+                                 dst_sq,
+                                 static_cast<Square>(src_sq - 4),
+                                 static_cast<Square>(dst_sq + 1));
+        case MoveType::EnPassant: {
+            // The captured pawn can also uncover a slider
+            Bitboard victim = turn == Color::White ? (dst >> 8) : (dst << 8);
+            Bitboard occupied = (all & ~src & ~victim) | dst;
+            Bitboard hv = rook_attacks(o_king_sq, 0, occupied);
+            Bitboard d12 = bishop_attacks(o_king_sq, 0, occupied);
+            return (check_squares[PieceType::Pawn] & dst) ||
+                   (hv & (f_rook | f_queen)) || (d12 & (f_bishop | f_queen));
+        }
+        case MoveType::KnightPromo:
+        case MoveType::KnightPromoCapture:
+            return check_squares[PieceType::Knight] & dst;
+        case MoveType::RookPromo:
+        case MoveType::RookPromoCapture:
+            return rook_attacks(dst_sq, 0, all & ~src) & o_king;
+        case MoveType::BishopPromo:
+        case MoveType::BishopPromoCapture:
+            return bishop_attacks(dst_sq, 0, all & ~src) & o_king;
+        case MoveType::QueenPromo:
+        case MoveType::QueenPromoCapture:
+            return queen_attacks(dst_sq, 0, all & ~src) & o_king;
+        default:
+            break;
+        }
+
+        // Any other move checks only from the check squares of its piece
+        PieceType piece = PieceType::King;
+        if (f_pawn & src) piece = PieceType::Pawn;
+        else if (f_knight & src) piece = PieceType::Knight;
+        else if (f_bishop & src) piece = PieceType::Bishop;
+        else if (f_rook & src) piece = PieceType::Rook;
+        else if (f_queen & src) piece = PieceType::Queen;
+        return check_squares[piece] & dst;
+    }
+
+    template bool MoveGen::generate<GenType::GenAll>(MoveList &moves);
+    template bool MoveGen::generate_prepared<GenType::GenAll>(MoveList &moves);
+    template bool MoveGen::generate<GenType::GenNoisy>(MoveList &moves);
+    template bool
+    MoveGen::generate_prepared<GenType::GenNoisy>(MoveList &moves);
+    template bool MoveGen::generate<GenType::GenQuiet>(MoveList &moves);
+    template bool
+    MoveGen::generate_prepared<GenType::GenQuiet>(MoveList &moves);
+    template bool MoveGen::generate<GenType::GenEvasions>(MoveList &moves);
+    template bool
+    MoveGen::generate_prepared<GenType::GenEvasions>(MoveList &moves);
+    template bool MoveGen::generate<GenType::GenQuietChecks>(MoveList &moves);
+    template bool
+    MoveGen::generate_prepared<GenType::GenQuietChecks>(MoveList &moves);
 } // namespace Brainiac
\ No newline at end of file
@@ -219,6 +219,43 @@ namespace Brainiac {
      */
     Bitboard pawn_captures(Square sq, Color turn);
 
+    /**
+     * @brief Compute pawn advance mask for a color known at compile time.
+     *
+     * @tparam C
+     * @param sq
+     * @return Bitboard
+     */
+    template <Color C>
+    constexpr Bitboard pawn_advances(Square sq) {
+        if constexpr (C == Color::White) return SQUARES[sq] << 8;
+        else return SQUARES[sq] >> 8;
+    }
+
+    /**
+     * @brief Compute pawn double mask for a color known at compile time.
+     *
+     * @tparam C
+     * @param sq
+     * @return Bitboard
+     */
+    template <Color C>
+    constexpr Bitboard pawn_doubles(Square sq) {
+        return PAWN_DOUBLE_MASKS[64 * C + sq];
+    }
+
+    /**
+     * @brief Compute pawn capture mask for a color known at compile time.
+     *
+     * @tparam C
+     * @param sq
+     * @return Bitboard
+     */
+    template <Color C>
+    constexpr Bitboard pawn_captures(Square sq) {
+        return PAWN_CAPTURE_MASKS[64 * C + sq];
+    }
+
     /**
      * @brief Compute knight attack mask.
      *
@@ -235,7 +272,13 @@ namespace Brainiac {
      * @param enemies
      * @return Bitboard
      */
-    Bitboard rook_attacks(Square sq, Bitboard friends, Bitboard enemies);
+    inline Bitboard
+    rook_attacks(Square sq, Bitboard friends, Bitboard enemies) {
+        const SlidingMoveTable &table = ROOK_ATTACK_TABLES[sq];
+        Bitboard index = slider_index(table, friends | enemies);
+
+        return table.move_masks[index] & ~friends;
+    }
 
     /**
      * @brief Compute bishop attack mask.
@@ -245,7 +288,13 @@ namespace Brainiac {
      * @param enemies
      * @return Bitboard
      */
-    Bitboard bishop_attacks(Square sq, Bitboard friends, Bitboard enemies);
+    inline Bitboard
+    bishop_attacks(Square sq, Bitboard friends, Bitboard enemies) {
+        const SlidingMoveTable &table = BISHOP_ATTACK_TABLES[sq];
+        Bitboard index = slider_index(table, friends | enemies);
+
+        return table.move_masks[index] & ~friends;
+    }
 
     /**
      * @brief Compute queen attack mask.
@@ -255,7 +304,59 @@ namespace Brainiac {
      * @param enemies
      * @return Bitboard
      */
-    Bitboard queen_attacks(Square sq, Bitboard friends, Bitboard enemies);
+    inline Bitboard
+    queen_attacks(Square sq, Bitboard friends, Bitboard enemies) {
+        Bitboard all = friends | enemies;
+
+        const SlidingMoveTable &r_table = ROOK_ATTACK_TABLES[sq];
+        Bitboard r_index = slider_index(r_table, all);
+
+        const SlidingMoveTable &b_table = BISHOP_ATTACK_TABLES[sq];
+        Bitboard b_index = slider_index(b_table, all);
+
+        return (r_table.move_masks[r_index] | b_table.move_masks[b_index]) &
+               ~friends;
+    }
+
+    /**
+     * @brief Test if a square is attacked by the opponent of the given turn.
+     *
+     * @param sq
+     * @param turn
+     * @param all
+     * @param o_pawn
+     * @param o_knight
+     * @param o_bishop
+     * @param o_rook
+     * @param o_queen
+     * @return true
+     * @return false
+     */
+    bool is_attacked(Square sq,
+                     Color turn,
+                     Bitboard all,
+                     Bitboard o_pawn,
+                     Bitboard o_knight,
+                     Bitboard o_bishop,
+                     Bitboard o_rook,
+                     Bitboard o_queen);
+
+    /**
+     * @brief Categories of legal moves that can be generated.
+     *
+     * Noisy moves are captures, en-passant and promotions. Quiet moves are
+     * everything else, so the two are disjoint and together form all moves.
+     * Evasions are all moves while in check and nothing otherwise. Quiet
+     * checks are the quiet moves that give check.
+     *
+     */
+    enum GenType : uint8_t {
+        GenAll,
+        GenNoisy,
+        GenQuiet,
+        GenEvasions,
+        GenQuietChecks,
+    };
 
     struct MoveGen {
         Bitboard friends;
@@ -281,15 +382,86 @@ namespace Brainiac {
         CastlingFlagSet castling;
 
         /**
-         * @brief Generate the moves and add them to the move list. Returns true
-         * if king is check.
+         * @brief Compute the attack, check and pin masks. These are shared by
+         * every generation category until the pieces change.
+         *
+         */
+        void prepare();
+
+        /**
+         * @brief Generate the moves of category G and add them to the move
+         * list. Returns true if king is check.
          *
+         * @tparam G
          * @param moves
          * @return true
          * @return false
          */
+        template <GenType G = GenType::GenAll>
         bool generate(MoveList &moves);
 
+        /**
+         * @brief Generate the moves of category G using the masks from
+         * `prepare`. Returns true if king is check.
+         *
+         * @tparam G
+         * @param moves
+         * @return true
+         * @return false
+         */
+        template <GenType G>
+        bool generate_prepared(MoveList &moves);
+
+        /**
+         * @brief Generate only the king moves using the masks from `prepare`.
+         * Returns true if king is check.
+         *
+         * @param moves
+         * @return true
+         * @return false
+         */
+        bool generate_king(MoveList &moves);
+
+        /**
+         * @brief Generate the moves of the remaining pieces. This must be
+         * called after `generate_king`.
+         *
+         * @param moves
+         */
+        void generate_others(MoveList &moves);
+
+        /**
+         * @brief Test if a move could be played by the side to move, ignoring
+         * whether it leaves the king in check. This only needs the piece
+         * bitboards, not the masks from `prepare`.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_pseudo_legal(Move move) const;
+
+        /**
+         * @brief Test if a pseudo-legal move keeps the king out of check,
+         * using the masks from `prepare`.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_legal(Move move) const;
+
+        /**
+         * @brief Test if a legal move checks the opponent king. The check
+         * squares are computed on first use and kept until the next
+         * `prepare`.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool gives_check(Move move);
+
       private:
         Bitboard o_king_attacks;
         Bitboard o_pawn_attacks;
@@ -312,12 +484,60 @@ namespace Brainiac {
         Bitboard pinmask_d12;
         Bitboard pinmask;
 
+        std::array<Bitboard, 6> check_squares;
+        Bitboard discover_blockers;
+        Square o_king_sq;
+        bool checks_ready;
+
         bool check;
 
+        /**
+         * @brief Test if a generation category includes quiet moves.
+         *
+         * @param gen
+         * @return true
+         * @return false
+         */
+        static constexpr bool has_quiets(GenType gen) {
+            return gen != GenType::GenNoisy;
+        }
+
+        /**
+         * @brief Test if a generation category includes noisy moves.
+         *
+         * @param gen
+         * @return true
+         * @return false
+         */
+        static constexpr bool has_noisy(GenType gen) {
+            return gen == GenType::GenAll || gen == GenType::GenNoisy ||
+                   gen == GenType::GenEvasions;
+        }
+
+        /**
+         * @brief Compute the attack, check and pin masks for the turn C.
+         *
+         * @tparam C
+         */
+        template <Color C>
+        void prepare();
+
+        /**
+         * @brief Generate the moves of category G for the turn C.
+         *
+         * @tparam C
+         * @tparam G
+         * @param moves
+         */
+        template <Color C, GenType G>
+        void generate_color(MoveList &moves);
+
         /**
          * @brief Compute the attackmask of the opponent.
          *
+         * @tparam C
          */
+        template <Color C>
         void compute_attackmask();
 
         /**
@@ -330,49 +550,121 @@ namespace Brainiac {
          * @brief Compute the checkmask, which is the path from any opponent
          * piece to the friendly king.
          *
+         * @tparam C
          */
+        template <Color C>
         void compute_checkmask();
 
+        /**
+         * @brief Compute the squares from which each piece type would check
+         * the opponent king, and the friendly pieces that would discover check
+         * by moving off their line.
+         *
+         * @tparam C
+         */
+        template <Color C>
+        void compute_checksquares();
+
+        /**
+         * @brief Compute the check squares unless they are up to date.
+         *
+         */
+        void load_checksquares();
+
+        /**
+         * @brief Filter the quiet targets of a piece by the generation
+         * category. Only quiet checks restrict the targets.
+         *
+         * @tparam G
+         * @param src_sq
+         * @param type
+         * @param targets
+         * @return Bitboard
+         */
+        template <GenType G>
+        Bitboard
+        quiet_targets(Square src_sq, PieceType type, Bitboard targets) const;
+
+        /**
+         * @brief Test if a castling move checks the opponent king.
+         *
+         * @param king_src
+         * @param king_dst
+         * @param rook_src
+         * @param rook_dst
+         * @return true
+         * @return false
+         */
+        bool castle_checks(Square king_src,
+                           Square king_dst,
+                           Square rook_src,
+                           Square rook_dst) const;
+
         /**
          * @brief Generate king moves.
          *
+         * @tparam C
+         * @tparam G
          * @param moves
          */
+        template <Color C, GenType G>
         void generate_king_moves(MoveList &moves);
 
         /**
          * @brief Generate pawn moves.
          *
+         * @tparam C
+         * @tparam G
          * @param moves
          */
+        template <Color C, GenType G>
         void generate_pawn_moves(MoveList &moves);
 
         /**
          * @brief Generate rook moves.
          *
+         * @tparam G
          * @param moves
          */
+        template <GenType G>
         void generate_rook_moves(MoveList &moves);
 
         /**
          * @brief Generate knight moves.
          *
+         * @tparam G
          * @param moves
          */
+        template <GenType G>
         void generate_knight_moves(MoveList &moves);
 
         /**
          * @brief Generate bishop moves.
          *
+         * @tparam G
          * @param moves
          */
+        template <GenType G>
         void generate_bishop_moves(MoveList &moves);
 
         /**
          * @brief Generate queen moves.
          *
+         * @tparam G
          * @param moves
          */
+        template <GenType G>
         void generate_queen_moves(MoveList &moves);
+
+        /**
+         * @brief Generate the moves of all non-king pieces, unless the king is
+         * double-checked.
+         *
+         * @tparam C
+         * @tparam G
+         * @param moves
+         */
+        template <Color C, GenType G>
+        void generate_pieces(MoveList &moves);
     };
 } // namespace Brainiac
\ No newline at end of file
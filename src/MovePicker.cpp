@@ -0,0 +1,192 @@
+#include "MovePicker.hpp"
+
+namespace Brainiac {
+    bool is_noisy(Move move) {
+        switch (move.type()) {
+        case MoveType::Capture:
+        case MoveType::EnPassant:
+        case MoveType::KnightPromo:
+        case MoveType::RookPromo:
+        case MoveType::BishopPromo:
+        case MoveType::QueenPromo:
+        case MoveType::KnightPromoCapture:
+        case MoveType::RookPromoCapture:
+        case MoveType::BishopPromoCapture:
+        case MoveType::QueenPromoCapture:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    MovePicker::MovePicker(Position &position,
+                           const History &htable,
+                           const Killers &killers,
+                           Depth ply,
+                           Move hash_move,
+                           bool qsearch) :
+        _position(position),
+        _htable(htable),
+        _hash_move(hash_move),
+        _qsearch(qsearch),
+        _stage(PickerStage::PickHash) {
+        // Quiescence search never visits the killers
+        for (unsigned i = 0; i < KILLERS_PER_PLY; i++) {
+            _killers[i] = qsearch ? Move() : killers.get(ply, i);
+        }
+        fill_stage();
+    }
+
+    void MovePicker::skip_move(Move move) {
+        if (move == Move()) return;
+        for (unsigned i = _index; i < _moves.size(); i++) {
+            if (_moves[i] == move) {
+                std::swap(_moves[i], _moves[_index]);
+                _index++;
+                break;
+            }
+        }
+    }
+
+    void MovePicker::fill_stage() {
+        switch (_stage) {
+        case PickerStage::PickHash: {
+            _moves.clear();
+            _index = 0;
+            _end = 0;
+            if (_hash_move == Move()) break;
+            if (_qsearch && !is_noisy(_hash_move)) break;
+
+            // Only trust the hash move if it is legal in this position, which
+            // is checked without generating any moves
+            if (_position.is_pseudo_legal(_hash_move) &&
+                _position.is_legal(_hash_move)) {
+                _moves.add(_hash_move);
+                _values[0] = MAX_MOVE_VALUE;
+                _end = 1;
+            }
+            break;
+        }
+        case PickerStage::PickCaptures: {
+            _moves.clear();
+            _position.moves(GenType::GenNoisy, _moves);
+            _index = 0;
+            skip_move(_hash_move);
+            _end = _moves.size();
+
+            // Prioritize queen and knight promotions over all others
+            for (unsigned i = _index; i < _end; i++) {
+                Move move = _moves[i];
+                switch (move.type()) {
+                case MoveType::Capture:
+                    _values[i] = 40 + see(_position, move);
+                    break;
+                case MoveType::QueenPromoCapture:
+                case MoveType::KnightPromoCapture:
+                    _values[i] = 50 + see(_position, move);
+                    break;
+                case MoveType::EnPassant:
+                case MoveType::QueenPromo:
+                case MoveType::KnightPromo:
+                    _values[i] = 20;
+                    break;
+                default:
+                    _values[i] = 0;
+                    break;
+                }
+            }
+            break;
+        }
+        case PickerStage::PickKillers: {
+            // Killers come from sibling nodes, so they are checked like the
+            // hash move. Those that are not played here are cleared so the
+            // quiet stage does not skip them.
+            _moves.clear();
+            _index = 0;
+            _end = 0;
+            for (Move &killer : _killers) {
+                bool repeated = false;
+                for (unsigned i = 0; i < _end; i++) {
+                    repeated |= _moves[i] == killer;
+                }
+                if (killer == Move() || killer == _hash_move ||
+                    is_noisy(killer) || repeated ||
+                    !_position.is_pseudo_legal(killer) ||
+                    !_position.is_legal(killer)) {
+                    killer = Move();
+                    continue;
+                }
+                _moves.add(killer);
+                _values[_end] = _htable.get(_position, killer);
+                _end++;
+            }
+            break;
+        }
+        case PickerStage::PickQuiets: {
+            _moves.clear();
+            _position.moves(GenType::GenQuiet, _moves);
+            _index = 0;
+            skip_move(_hash_move);
+            for (Move killer : _killers) {
+                skip_move(killer);
+            }
+            _end = _moves.size();
+
+            // Prioritize moves with higher history heuristic
+            for (unsigned i = _index; i < _end; i++) {
+                Move move = _moves[i];
+                MoveValue value = _htable.get(_position, move);
+                switch (move.type()) {
+                case MoveType::KingCastle:
+                case MoveType::QueenCastle:
+                case MoveType::PawnDouble:
+                    value += 10;
+                    break;
+                default:
+                    break;
+                }
+                _values[i] = value;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    void MovePicker::select_best() {
+        unsigned best = _index;
+        for (unsigned i = _index + 1; i < _end; i++) {
+            if (_values[i] > _values[best]) {
+                best = i;
+            }
+        }
+        std::swap(_moves[best], _moves[_index]);
+        std::swap(_values[best], _values[_index]);
+    }
+
+    bool MovePicker::next(Move &move) {
+        while (_stage != PickerStage::PickDone) {
+            if (_index < _end) {
+                select_best();
+                move = _moves[_index];
+                _value = _values[_index];
+                _index++;
+                return true;
+            }
+
+            // Quiescence search stops after the captures
+            if (_qsearch && _stage == PickerStage::PickCaptures) {
+                _stage = PickerStage::PickDone;
+            } else {
+                _stage = static_cast<PickerStage>(_stage + 1);
+            }
+            fill_stage();
+        }
+        return false;
+    }
+
+    MoveValue MovePicker::value() const { return _value; }
+
+    PickerStage MovePicker::stage() const { return _stage; }
+} // namespace Brainiac
\ No newline at end of file
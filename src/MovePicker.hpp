@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+
+#include "History.hpp"
+#include "Killers.hpp"
+#include "Move.hpp"
+#include "MoveList.hpp"
+#include "Numeric.hpp"
+#include "Position.hpp"
+#include "StaticExchange.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Stages of the move picker, in the order they are visited.
+     *
+     */
+    enum PickerStage : uint8_t {
+        PickHash,
+        PickCaptures,
+        PickKillers,
+        PickQuiets,
+        PickDone
+    };
+
+    /**
+     * @brief Test if a move is searched by quiescence (captures, en-passant
+     * and promotions, as generated by `GenNoisy`).
+     *
+     * @param move
+     * @return true
+     * @return false
+     */
+    bool is_noisy(Move move);
+
+    /**
+     * @brief Yields the moves of a node in stages: the hash move, captures
+     * ordered by SEE, killer moves, then quiet moves ordered by history.
+     *
+     * Each move is scored once when its stage begins, and later stages are
+     * never visited if the search cuts off early. The hash move and killers
+     * are validated without generating moves, so quiet moves are only
+     * generated if neither causes a cutoff. Quiescence search only
+     * visits the hash move and the captures.
+     *
+     */
+    class MovePicker {
+        Position &_position;
+        const History &_htable;
+        std::array<Move, KILLERS_PER_PLY> _killers;
+        Move _hash_move;
+        bool _qsearch;
+
+        PickerStage _stage;
+        MoveList _moves;
+        std::array<MoveValue, MAX_MOVES_PER_TURN> _values;
+        unsigned _index;
+        MoveValue _value;
+
+        unsigned _end;
+
+        /**
+         * @brief Move an already yielded move, if it is among the remaining
+         * moves of the stage, behind the current index so it is not yielded
+         * twice.
+         *
+         * @param move
+         */
+        void skip_move(Move move);
+
+        /**
+         * @brief Collect and score the moves of the current stage.
+         *
+         */
+        void fill_stage();
+
+        /**
+         * @brief Swap the best remaining move of the stage to the front.
+         *
+         */
+        void select_best();
+
+      public:
+        /**
+         * @brief Construct a MovePicker.
+         *
+         * @param position
+         * @param htable
+         * @param killers
+         * @param ply
+         * @param hash_move Move from the transposition table, or a null move.
+         * @param qsearch
+         */
+        MovePicker(Position &position,
+                   const History &htable,
+                   const Killers &killers,
+                   Depth ply,
+                   Move hash_move,
+                   bool qsearch);
+
+        /**
+         * @brief Get the next move. Returns false once all stages are done.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool next(Move &move);
+
+        /**
+         * @brief Get the ordering value of the last move returned.
+         *
+         * @return MoveValue
+         */
+        MoveValue value() const;
+
+        /**
+         * @brief Get the current stage.
+         *
+         * @return PickerStage
+         */
+        PickerStage stage() const;
+    };
+} // namespace Brainiac
\ No newline at end of file
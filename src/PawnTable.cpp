@@ -0,0 +1,26 @@
+#include "PawnTable.hpp"
+
+namespace Brainiac {
+    PawnTable::PawnTable() : _entries(PAWN_TABLE_SIZE) {}
+
+    PawnEntry &PawnTable::probe(Hash key, bool &hit) {
+        PawnEntry &entry = _entries[key & (PAWN_TABLE_SIZE - 1)];
+        hit = entry.key == key;
+
+        TableStats::increment(_stats.probes);
+        if (hit) {
+            TableStats::increment(_stats.hits);
+        } else if (entry.key) {
+            TableStats::increment(_stats.overwrites);
+        }
+        return entry;
+    }
+
+    TableStats PawnTable::stats() const { return _stats.load(); }
+
+    void PawnTable::reset_stats() { _stats.reset(); }
+
+    void PawnTable::clear() {
+        std::fill(_entries.begin(), _entries.end(), PawnEntry());
+    }
+} // namespace Brainiac
\ No newline at end of file
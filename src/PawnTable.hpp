@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "Bitboard.hpp"
+#include "Hasher.hpp"
+#include "Numeric.hpp"
+#include "TableStats.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Number of entries in a pawn hash table (must be a power of 2).
+     *
+     */
+    constexpr std::size_t PAWN_TABLE_SIZE = 1 << 13;
+
+    /**
+     * @brief Cached evaluation of a pawn structure.
+     *
+     */
+    struct PawnEntry {
+        /**
+         * @brief Pawn hash of the structure.
+         *
+         */
+        Hash key = 0;
+
+        /**
+         * @brief Pawn structure score of each color from its own perspective.
+         *
+         */
+        std::array<Value, 2> value = {0, 0};
+
+        /**
+         * @brief Squares attacked by the pawns of each color.
+         *
+         */
+        std::array<Bitboard, 2> attacks = {0, 0};
+
+        /**
+         * @brief Squares the pawns of each color could attack as they advance.
+         *
+         */
+        std::array<Bitboard, 2> attack_spans = {0, 0};
+
+        /**
+         * @brief Passed pawns of each color.
+         *
+         */
+        std::array<Bitboard, 2> passed = {0, 0};
+    };
+
+    /**
+     * @brief Pawn hash table.
+     *
+     * Pawn structure changes rarely between sibling nodes, so its evaluation
+     * is cached by pawn hash. Each search thread owns its own table, so it is
+     * not synchronized.
+     *
+     * Entries start zeroed, which is the correct entry for a board without
+     * pawns (pawn hash 0).
+     *
+     */
+    class PawnTable {
+        std::vector<PawnEntry> _entries;
+        TableStats _stats;
+
+      public:
+        PawnTable();
+
+        /**
+         * @brief Find the entry of a pawn hash.
+         *
+         * If the slot holds another structure, it is returned with `hit` set
+         * to false so the caller can overwrite it.
+         *
+         * @param key
+         * @param hit
+         * @return PawnEntry&
+         */
+        PawnEntry &probe(Hash key, bool &hit);
+
+        /**
+         * @brief Get the usage counters.
+         *
+         * @return TableStats
+         */
+        TableStats stats() const;
+
+        /**
+         * @brief Reset the usage counters.
+         *
+         */
+        void reset_stats();
+
+        /**
+         * @brief Clear all entries.
+         *
+         */
+        void clear();
+    };
+} // namespace Brainiac
\ No newline at end of file
@@ -1,11 +1,11 @@
 #include "Piece.hpp"
 
 namespace Brainiac {
-    Piece create_piece(PieceType type, Color color) {
-        return static_cast<Piece>(color * 6 + type);
-    }
-
     Color get_piece_color(Piece piece) {
         return static_cast<Color>(piece >= 6);
     }
+
+    PieceType get_piece_type(Piece piece) {
+        return static_cast<PieceType>(piece % 6);
+    }
 } // namespace Brainiac
\ No newline at end of file
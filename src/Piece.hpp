@@ -80,7 +80,9 @@ namespace Brainiac {
      * @param color
      * @return Piece
      */
-    Piece create_piece(PieceType type, Color color);
+    constexpr Piece create_piece(PieceType type, Color color) {
+        return static_cast<Piece>(color * 6 + type);
+    }
 
     /**
      * @brief Get the color of a piece.
@@ -89,4 +91,12 @@ namespace Brainiac {
      * @return Color
      */
     Color get_piece_color(Piece piece);
+
+    /**
+     * @brief Get the type of a piece.
+     *
+     * @param piece
+     * @return PieceType
+     */
+    PieceType get_piece_type(Piece piece);
 } // namespace Brainiac
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+
+#include "Numeric.hpp"
+#include "Piece.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Piece weights from white's perspective.
+     *
+     */
+    constexpr std::array<Value, 12> PIECE_WEIGHTS = {
+        100,
+        10,
+        50,
+        32,
+        33,
+        90,
+        -100,
+        -10,
+        -50,
+        -32,
+        -33,
+        -90,
+    };
+
+    /**
+     * @brief The matrices below determine the placement scores of each piece
+     * on the board.
+     *
+     * The higher the score at a particular index, the more favorable
+     * that location for that piece.
+     *
+     * Note that value placement is from the perspective of white from the
+     * visual representation of the board, i.e., starting position is on the
+     * bottom 2 rows.
+     */
+    // clang-format off
+    constexpr std::array<Value, 64> QUEEN_MATRIX = {
+        -20,-10,-10, -5, -5,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5,  5,  5,  5,  0,-10,
+        -5,  0,  5,  5,  5,  5,  0, -5,
+        0,  0,  5,  5,  5,  5,  0, -5,
+        -10,  5,  5,  5,  5,  5,  0,-10,
+        -10,  0,  5,  0,  0,  0,  0,-10,
+        -20,-10,-10, -5, -5,-10,-10,-20
+    };
+    constexpr std::array<Value, 64> BISHOP_MATRIX = {
+        -20,-10,-10,-10,-10,-10,-10,-20,
+        -10,  0,  0,  0,  0,  0,  0,-10,
+        -10,  0,  5, 10, 10,  5,  0,-10,
+        -10,  5,  5, 10, 10,  5,  5,-10,
+        -10,  0, 10, 10, 10, 10,  0,-10,
+        -10, 10, 10, 10, 10, 10, 10,-10,
+        -10,  5,  0,  0,  0,  0,  5,-10,
+        -20,-10,-10,-10,-10,-10,-10,-20,
+    };
+    constexpr std::array<Value, 64> KNIGHT_MATRIX = {
+        -50,-40,-30,-30,-30,-30,-40,-50,
+        -40,-20,  0,  0,  0,  0,-20,-40,
+        -30,  0, 10, 15, 15, 10,  0,-30,
+        -30,  5, 15, 20, 20, 15,  5,-30,
+        -30,  0, 15, 20, 20, 15,  0,-30,
+        -30,  5, 10, 15, 15, 10,  5,-30,
+        -40,-20,  0,  5,  5,  0,-20,-40,
+        -50,-40,-30,-30,-30,-30,-40,-50,
+    };
+    constexpr std::array<Value, 64> ROOK_MATRIX = {
+        0,  0,  0,  0,  0,  0,  0,  0,
+        5, 10, 10, 10, 10, 10, 10,  5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        -5,  0,  0,  0,  0,  0,  0, -5,
+        0,  0,  0,  5,  5,  0,  0,  0
+    };
+    constexpr std::array<Value, 64> PAWN_MATRIX = {
+        0,  0,  0,  0,  0,  0,  0,  0,
+        70, 70, 70, 70, 70, 70, 70, 70,
+        10, 10, 20, 40, 40, 20, 10, 10,
+        5,  5, 10, 35, 35, 10,  5,  5,
+        0,  0,  0, 30, 30,  0,  0,  0,
+        5, -5,-10,  0,  0,-10, -5,  5,
+        5, 10, 10,-20,-20, 10, 10,  5,
+        0,  0,  0,  0,  0,  0,  0,  0,
+    };
+    constexpr std::array<Value, 64> KING_MATRIX = {
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -30,-40,-40,-50,-50,-40,-40,-30,
+        -20,-30,-30,-40,-40,-30,-30,-20,
+        -10,-20,-20,-20,-20,-20,-20,-10,
+        20, 20,  0,  0,  0,  0, 20, 20,
+        20, 30, 10,  0,  0, 10, 30, 20
+    };
+    // clang-format on
+
+    /**
+     * @brief Build the material score of each piece, with a zero entry for
+     * empty squares.
+     *
+     * @return std::array<Value, 13>
+     */
+    constexpr std::array<Value, 13> build_material_scores() {
+        std::array<Value, 13> scores = {};
+        for (unsigned i = 0; i < 12; i++) {
+            scores[i] = PIECE_WEIGHTS[i];
+        }
+        return scores;
+    }
+
+    /**
+     * @brief Build the placement score of each piece on each square from
+     * white's perspective, with a zero row for empty squares.
+     *
+     * @return std::array<std::array<Value, 64>, 13>
+     */
+    constexpr std::array<std::array<Value, 64>, 13> build_placement_scores() {
+        const std::array<Value, 64> *matrices[6] = {
+            &KING_MATRIX,
+            &PAWN_MATRIX,
+            &ROOK_MATRIX,
+            &KNIGHT_MATRIX,
+            &BISHOP_MATRIX,
+            &QUEEN_MATRIX,
+        };
+        std::array<std::array<Value, 64>, 13> scores = {};
+        for (unsigned type = 0; type < 6; type++) {
+            for (unsigned sq = 0; sq < 64; sq++) {
+                // The matrices list the eighth rank first
+                scores[type][sq] = (*matrices[type])[sq ^ 56];
+                scores[type + 6][sq] = -(*matrices[type])[sq];
+            }
+        }
+        return scores;
+    }
+
+    /**
+     * @brief Material score by piece, indexable by `Piece::Empty`.
+     *
+     */
+    constexpr std::array<Value, 13> MATERIAL_SCORES = build_material_scores();
+
+    /**
+     * @brief Placement score by piece and square, indexable by `Piece::Empty`.
+     *
+     */
+    constexpr std::array<std::array<Value, 64>, 13> PLACEMENT_SCORES =
+        build_placement_scores();
+} // namespace Brainiac
\ No newline at end of file
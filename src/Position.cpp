@@ -2,33 +2,91 @@
 #include "Square.hpp"
 
 namespace Brainiac {
-    Position::Position(std::string fen, Hasher hasher) {
-        _states.reserve(128);
-        _states.emplace_back(fen, hasher);
+    Position::Position(std::string fen) :
+        _states(std::make_unique<State[]>(MAX_STATES)) {
+        _states[0] = State(fen, _board);
         _index = 0;
-        _hasher = hasher;
+        _size = 1;
     }
 
-    State &Position::push_state() {
-        _states.resize(_index + 1);
-        _states.emplace_back(_states[_index]);
+    Position::Position(const Position &other) :
+        _states(std::make_unique<State[]>(MAX_STATES)) {
+        *this = other;
+    }
+
+    Position &Position::operator=(const Position &other) {
+        if (this == &other) return *this;
+        if (!_states) _states = std::make_unique<State[]>(MAX_STATES);
+
+        _board = other._board;
+        _history = other._history;
+        for (unsigned i = 0; i < other._index; i++) {
+            _history.push_back(other._states[i].hash);
+        }
+        _states[0] = other._states[other._index];
+        _index = 0;
+        _size = 1;
+        return *this;
+    }
+
+    void Position::rebase() {
+        for (unsigned i = 0; i < _index; i++) {
+            _history.push_back(_states[i].hash);
+        }
+        _states[0] = _states[_index];
+        _index = 0;
+        _size = 1;
+    }
+
+    State &Position::push_state(Move move) {
+        assert(_index + 1 < MAX_STATES);
         _index++;
+        _size = _index + 1;
 
-        _states[_index].halfmoves++;
-        return _states[_index];
+        State &state = _states[_index];
+        state.inherit(_states[_index - 1]);
+        state.move = move;
+        state.halfmoves++;
+        return state;
     }
 
     std::string Position::fen(bool include_counters) const {
-        return _states[_index].fen(include_counters);
+        return _states[_index].fen(_board, include_counters);
     }
 
     Hash Position::hash() const { return _states[_index].hash; }
 
-    const Board &Position::board() const { return _states[_index].board; }
+    Hash Position::pawn_hash() const { return _states[_index].pawn_hash; }
+
+    Hash Position::material_hash() const {
+        return _states[_index].material_hash;
+    }
+
+    const Board &Position::board() const { return _board; }
 
     Color Position::turn() const { return _states[_index].turn; }
 
-    const MoveList &Position::moves() const { return _states[_index].moves; }
+    const MoveList &Position::moves() const {
+        const State &state = _states[_index];
+        state.generate_moves(_board);
+        return state.moves;
+    }
+
+    void Position::moves(GenType gen, MoveList &moves) const {
+        _states[_index].generate_moves(_board, gen, moves);
+    }
+
+    bool Position::is_pseudo_legal(Move move) const {
+        return _states[_index].is_pseudo_legal(_board, move);
+    }
+
+    bool Position::is_legal(Move move) const {
+        return _states[_index].is_legal(_board, move);
+    }
+
+    bool Position::gives_check(Move move) const {
+        return _states[_index].gives_check(_board, move);
+    }
 
     const CastlingFlagSet Position::castling() const {
         return _states[_index].castling;
@@ -41,57 +99,73 @@ namespace Brainiac {
     bool Position::is_check() const { return _states[_index].check; }
 
     bool Position::is_checkmate() const {
-        return is_check() && moves().size() == 0;
+        return is_check() && !_states[_index].has_moves(_board);
     }
 
     bool Position::is_stalemate() const {
-        return !is_check() && moves().size() == 0;
+        return !is_check() && !_states[_index].has_moves(_board);
     }
 
     bool Position::is_draw() const {
+        return is_rule_draw() || is_repetition();
+    }
+
+    bool Position::is_rule_draw() const {
         const State &state = _states[_index];
-        Bitboard all = state.board.bitboard(Color::Black) |
-                       state.board.bitboard(Color::White);
+        Bitboard all =
+            _board.bitboard(Color::Black) | _board.bitboard(Color::White);
         unsigned rem = count_set_bitboard(all);
         return is_stalemate() || state.halfmoves >= 100 || rem == 2;
     }
 
-    bool Position::is_start() const { return _index == 0; }
-
-    bool Position::is_end() const { return _index == _states.size() - 1; }
-
-    bool Position::is_quiet() {
-        // Check if any moves will significantly affect evaluation
-        for (Move move : moves()) {
-            switch (move.type()) {
-            case MoveType::Capture:
-            case MoveType::QueenPromoCapture:
-            case MoveType::KnightPromoCapture:
-            case MoveType::BishopPromoCapture:
-            case MoveType::RookPromoCapture:
-            case MoveType::QueenPromo:
-            case MoveType::KnightPromo:
-            case MoveType::BishopPromo:
-            case MoveType::RookPromo:
-                return false;
-            default:
+    bool Position::is_repetition() const {
+        const State &state = _states[_index];
+        unsigned limit = std::min(state.halfmoves, state.null_plies);
+
+        // Only the same side to move can repeat, so step back two plies at a
+        // time until the last irreversible move
+        unsigned count = 0;
+        for (unsigned ply = 4; ply <= limit; ply += 2) {
+            Hash hash;
+            if (ply <= _index) {
+                hash = _states[_index - ply].hash;
+            } else if (ply - _index <= _history.size()) {
+                hash = _history[_history.size() - (ply - _index)];
+            } else {
                 break;
             }
+            if (hash != state.hash) continue;
+
+            // A repeat after the root is a draw inside the search tree
+            if (ply < _index || ++count == 2) return true;
         }
+        return false;
+    }
+
+    bool Position::is_start() const { return _index == 0; }
 
+    bool Position::is_end() const { return _index == _size - 1; }
+
+    bool Position::is_quiet() {
         // Make sure current turn isn't in check
-        return !is_check();
+        if (is_check()) return false;
+
+        // Check if any moves will significantly affect evaluation
+        MoveList noisy;
+        moves(GenType::GenNoisy, noisy);
+        return noisy.size() == 0;
     }
 
     void Position::make(Move move) {
-        State &state = push_state();
+        State &state = push_state(move);
 
         Square src_sq = move.src();
         Square dst_sq = move.dst();
         MoveType move_type = move.type();
 
-        Piece src_piece = state.board.get(src_sq);
-        Piece dst_piece = state.board.get(dst_sq);
+        Piece src_piece = _board.get(src_sq);
+        Piece dst_piece = _board.get(dst_sq);
+        state.captured = dst_piece;
 
         // Clear castling rights if relevant pieces were moved
         switch (src_piece) {
@@ -99,18 +173,18 @@ namespace Brainiac {
             CastlingFlagSet king_side = (1 << CastlingRight::WK);
             CastlingFlagSet queen_side = (1 << CastlingRight::WQ);
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             break;
         }
         case Piece::BlackKing: {
             CastlingFlagSet king_side = (1 << CastlingRight::BK);
             CastlingFlagSet queen_side = (1 << CastlingRight::BQ);
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
         }
         case Piece::WhiteRook: {
             Bitboard rook_mask = 1ULL << src_sq;
@@ -123,9 +197,9 @@ namespace Brainiac {
                 -static_cast<bool>(rook_mask & FILES[0] & RANKS[0]);
             CastlingFlagSet queen_side = (1 << CastlingRight::WQ) & queen_mask;
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             break;
         }
         case Piece::BlackRook: {
@@ -139,9 +213,9 @@ namespace Brainiac {
                 -static_cast<bool>(rook_mask & FILES[0] & RANKS[7]);
             CastlingFlagSet queen_side = (1 << CastlingRight::BQ) & queen_mask;
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             break;
         }
         default:
@@ -161,9 +235,9 @@ namespace Brainiac {
                 -static_cast<bool>(rook_mask & FILES[0] & RANKS[0]);
             CastlingFlagSet queen_side = (1 << CastlingRight::WQ) & queen_mask;
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             break;
         }
         case Piece::BlackRook: {
@@ -177,9 +251,9 @@ namespace Brainiac {
                 -static_cast<bool>(rook_mask & FILES[0] & RANKS[7]);
             CastlingFlagSet queen_side = (1 << CastlingRight::BQ) & queen_mask;
 
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             state.castling &= ~(king_side | queen_side);
-            state.hash ^= _hasher.bitstring(state.castling);
+            state.hash ^= bitstring(state.castling);
             break;
         }
         default:
@@ -190,57 +264,62 @@ namespace Brainiac {
         switch (move_type) {
         case MoveType::KnightPromo:
         case MoveType::KnightPromoCapture:
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             src_piece = create_piece(PieceType::Knight, state.turn);
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             break;
         case MoveType::RookPromo:
         case MoveType::RookPromoCapture:
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             src_piece = create_piece(PieceType::Rook, state.turn);
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             break;
         case MoveType::BishopPromo:
         case MoveType::BishopPromoCapture:
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             src_piece = create_piece(PieceType::Bishop, state.turn);
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             break;
         case MoveType::QueenPromo:
         case MoveType::QueenPromoCapture:
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             src_piece = create_piece(PieceType::Queen, state.turn);
-            state.hash ^= _hasher.bitstring(src_sq, src_piece);
+            state.hash ^= bitstring(src_sq, src_piece);
             break;
         case MoveType::PawnDouble:
-            state.hash ^= _hasher.bitstring(state.ep_dst) &
+            state.hash ^= bitstring(state.ep_dst) &
                           -(state.ep_dst != Square::Null);
             state.ep_dst = static_cast<Square>(src_sq + (dst_sq - src_sq) / 2);
-            state.hash ^= _hasher.bitstring(state.ep_dst);
+            state.hash ^= bitstring(state.ep_dst);
             break;
         case MoveType::EnPassant: {
             // Map turn Color [0, 1] to Direction [1, -1]
             int pawn_dir = ((1 - state.turn) * 2) - 1;
 
             Square target = static_cast<Square>(state.ep_dst - (8 * pawn_dir));
-            Piece target_piece = state.board.get(target);
+            Piece target_piece = _board.get(target);
+            state.captured = target_piece;
 
-            state.board.clear(target);
+            _board.clear(target);
 
-            state.hash ^= _hasher.bitstring(target, target_piece);
+            state.hash ^= bitstring(target, target_piece);
+            state.pawn_hash ^= bitstring(target, target_piece);
+            state.material_hash ^= material_bitstring(
+                target_piece,
+                count_set_bitboard(_board.bitboard(target_piece)));
             break;
         }
 
         case MoveType::KingCastle: {
             Square rook_sq = static_cast<Square>(state.turn * 56 + 7);
             Square rook_dst_sq = static_cast<Square>(dst_sq - 1);
-            Piece rook_piece = state.board.get(rook_sq);
+            Piece rook_piece = _board.get(rook_sq);
 
-            state.board.set(rook_dst_sq, rook_piece);
-            state.board.clear(rook_sq);
+            _board.set(rook_dst_sq, rook_piece);
+            _board.clear(rook_sq);
 
-            state.hash ^= _hasher.bitstring(rook_sq, rook_piece);
-            state.hash ^= _hasher.bitstring(rook_dst_sq, rook_piece);
+            state.hash ^= bitstring(rook_sq, rook_piece);
+            state.hash ^= bitstring(rook_dst_sq, rook_piece);
             break;
         }
         case MoveType::QueenCastle: {
@@ -248,13 +327,13 @@ namespace Brainiac {
                 static_cast<std::underlying_type_t<Color>>(state.turn) *
                 static_cast<std::underlying_type_t<Square>>(Square::A8));
             Square rook_dst_sq = static_cast<Square>(dst_sq + 1);
-            Piece rook_piece = state.board.get(rook_sq);
+            Piece rook_piece = _board.get(rook_sq);
 
-            state.board.set(rook_dst_sq, rook_piece);
-            state.board.clear(rook_sq);
+            _board.set(rook_dst_sq, rook_piece);
+            _board.clear(rook_sq);
 
-            state.hash ^= _hasher.bitstring(rook_sq, rook_piece);
-            state.hash ^= _hasher.bitstring(rook_dst_sq, rook_piece);
+            state.hash ^= bitstring(rook_sq, rook_piece);
+            state.hash ^= bitstring(rook_dst_sq, rook_piece);
             break;
         }
 
@@ -262,12 +341,24 @@ namespace Brainiac {
             break;
         }
 
+        // Swap a promoted pawn for the new piece in the pawn and material keys
+        Piece pawn = _board.get(src_sq);
+        if (src_piece != pawn) {
+            Bitboard pawns = _board.bitboard(pawn);
+            Bitboard promoted = _board.bitboard(src_piece);
+            state.pawn_hash ^= bitstring(src_sq, pawn);
+            state.material_hash ^=
+                material_bitstring(pawn, count_set_bitboard(pawns) - 1);
+            state.material_hash ^=
+                material_bitstring(src_piece, count_set_bitboard(promoted));
+        }
+
         // Clear the en passant square on all move types except pawn double
         switch (move_type) {
         case MoveType::PawnDouble:
             break;
         default:
-            state.hash ^= _hasher.bitstring(state.ep_dst) &
+            state.hash ^= bitstring(state.ep_dst) &
                           -(state.ep_dst != Square::Null);
             state.ep_dst = Square::Null;
             break;
@@ -294,36 +385,180 @@ namespace Brainiac {
             break;
         }
 
+        // Remove a captured piece from the pawn and material keys
+        if (dst_piece != Piece::Empty) {
+            Bitboard captured = _board.bitboard(dst_piece);
+            bool pawn_captured =
+                dst_piece == WhitePawn || dst_piece == BlackPawn;
+            state.pawn_hash ^= bitstring(dst_sq, dst_piece) & -pawn_captured;
+            state.material_hash ^=
+                material_bitstring(dst_piece, count_set_bitboard(captured) - 1);
+        }
+
+        // Promoted pawns were already removed from the pawn key
+        bool pawn_moved = src_piece == WhitePawn || src_piece == BlackPawn;
+        state.pawn_hash ^=
+            (bitstring(src_sq, src_piece) ^ bitstring(dst_sq, src_piece)) &
+            -pawn_moved;
+
         // Move the src piece
-        state.board.set(dst_sq, src_piece);
-        state.board.clear(src_sq);
+        _board.set(dst_sq, src_piece);
+        _board.clear(src_sq);
 
-        state.hash ^= _hasher.bitstring(src_sq, src_piece);
-        state.hash ^= _hasher.bitstring(dst_sq, src_piece);
+        state.hash ^= bitstring(src_sq, src_piece);
+        state.hash ^= bitstring(dst_sq, src_piece);
         state.hash ^=
-            _hasher.bitstring(dst_sq, dst_piece) & -(dst_piece != Piece::Empty);
+            bitstring(dst_sq, dst_piece) & -(dst_piece != Piece::Empty);
 
         // Update turn and fullmove counter
         state.fullmoves += (state.turn == Color::Black);
         state.turn = static_cast<Color>(!state.turn);
-        state.hash ^= _hasher.bitstring(state.turn);
+        state.hash ^= bitstring(state.turn);
 
-        state.generate_moves();
+        state.detect_check(_board, move);
     }
 
-    void Position::undo() { _index--; }
+    void Position::undo() {
+        const State &state = _states[_index];
+        _index--;
 
-    void Position::redo() { _index++; }
+        Move move = state.move;
+        MoveType move_type = move.type();
+        if (move_type == MoveType::Skip) return;
+
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        Color turn = _states[_index].turn;
+
+        // Demote promoted pieces back to a pawn
+        Piece src_piece = _board.get(dst_sq);
+        switch (move_type) {
+        case MoveType::KnightPromo:
+        case MoveType::KnightPromoCapture:
+        case MoveType::RookPromo:
+        case MoveType::RookPromoCapture:
+        case MoveType::BishopPromo:
+        case MoveType::BishopPromoCapture:
+        case MoveType::QueenPromo:
+        case MoveType::QueenPromoCapture:
+            src_piece = create_piece(PieceType::Pawn, turn);
+            break;
+        default:
+            break;
+        }
+
+        _board.set(src_sq, src_piece);
+        _board.clear(dst_sq);
+
+        // Restore the captured piece and move back castled rooks
+        switch (move_type) {
+        case MoveType::EnPassant: {
+            int pawn_dir = ((1 - turn) * 2) - 1;
+            Square target = static_cast<Square>(dst_sq - (8 * pawn_dir));
+            _board.set(target, state.captured);
+            break;
+        }
+        case MoveType::KingCastle: {
+            Square rook_sq = static_cast<Square>(turn * 56 + 7);
+            Square rook_dst_sq = static_cast<Square>(dst_sq - 1);
+            _board.set(rook_sq, _board.get(rook_dst_sq));
+            _board.clear(rook_dst_sq);
+            break;
+        }
+        case MoveType::QueenCastle: {
+            Square rook_sq = static_cast<Square>(turn * 56);
+            Square rook_dst_sq = static_cast<Square>(dst_sq + 1);
+            _board.set(rook_sq, _board.get(rook_dst_sq));
+            _board.clear(rook_dst_sq);
+            break;
+        }
+        default:
+            if (state.captured != Piece::Empty) {
+                _board.set(dst_sq, state.captured);
+            }
+            break;
+        }
+    }
+
+    void Position::redo() {
+        _index++;
+        replay(_states[_index]);
+    }
+
+    void Position::replay(const State &state) {
+        Move move = state.move;
+        MoveType move_type = move.type();
+        if (move_type == MoveType::Skip) return;
+
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        Color turn = _states[_index - 1].turn;
+
+        Piece src_piece = _board.get(src_sq);
+        switch (move_type) {
+        case MoveType::KnightPromo:
+        case MoveType::KnightPromoCapture:
+            src_piece = create_piece(PieceType::Knight, turn);
+            break;
+        case MoveType::RookPromo:
+        case MoveType::RookPromoCapture:
+            src_piece = create_piece(PieceType::Rook, turn);
+            break;
+        case MoveType::BishopPromo:
+        case MoveType::BishopPromoCapture:
+            src_piece = create_piece(PieceType::Bishop, turn);
+            break;
+        case MoveType::QueenPromo:
+        case MoveType::QueenPromoCapture:
+            src_piece = create_piece(PieceType::Queen, turn);
+            break;
+        case MoveType::EnPassant: {
+            int pawn_dir = ((1 - turn) * 2) - 1;
+            _board.clear(static_cast<Square>(dst_sq - (8 * pawn_dir)));
+            break;
+        }
+        case MoveType::KingCastle: {
+            Square rook_sq = static_cast<Square>(turn * 56 + 7);
+            Square rook_dst_sq = static_cast<Square>(dst_sq - 1);
+            _board.set(rook_dst_sq, _board.get(rook_sq));
+            _board.clear(rook_sq);
+            break;
+        }
+        case MoveType::QueenCastle: {
+            Square rook_sq = static_cast<Square>(turn * 56);
+            Square rook_dst_sq = static_cast<Square>(dst_sq + 1);
+            _board.set(rook_dst_sq, _board.get(rook_sq));
+            _board.clear(rook_sq);
+            break;
+        }
+        default:
+            break;
+        }
+
+        _board.set(dst_sq, src_piece);
+        _board.clear(src_sq);
+    }
 
     void Position::skip() {
-        State &state = push_state();
+        State &state = push_state(Move());
+
+        // The en passant square cannot be claimed by the side that made it
+        state.null_plies = 0;
+        state.hash ^=
+            bitstring(state.ep_dst) & -(state.ep_dst != Square::Null);
+        state.ep_dst = Square::Null;
 
         // Update state
         state.fullmoves += (state.turn == Color::Black);
         state.turn = static_cast<Color>(!state.turn);
-        state.hash ^= _hasher.bitstring(state.turn);
+        state.hash ^= bitstring(state.turn);
+
+        state.detect_check(_board);
+    }
 
-        state.generate_moves();
+    void Position::play(Move move) {
+        make(move);
+        rebase();
     }
 
     Move Position::find_move(const Square src,
@@ -374,5 +609,5 @@ namespace Brainiac {
                          promotion);
     }
 
-    void Position::print() const { _states[_index].print(); }
+    void Position::print() const { _states[_index].print(_board); }
 } // namespace Brainiac
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,25 +16,71 @@ namespace Brainiac {
     static const std::string DEFAULT_BOARD_FEN =
         "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 
+    /**
+     * @brief Capacity of the state stack, enough for the root and every ply
+     * of the deepest search.
+     *
+     */
+    constexpr unsigned MAX_STATES = MAX_DEPTH + 1;
+
     /**
      * @brief Game position simulation.
      *
+     * States are pushed onto a fixed stack that is allocated once. Moves
+     * played in the game are folded into a separate history of hashes, so
+     * the stack only holds the root and the moves made on top of it.
+     *
      */
     class Position {
-        std::vector<State> _states;
+        Board _board;
+        std::vector<Hash> _history;
+        std::unique_ptr<State[]> _states;
         unsigned _index;
-        Hasher _hasher;
+        unsigned _size;
 
         /**
-         * @brief Push a new state onto the array, overwriting any states ahead
+         * @brief Push a new state onto the stack, overwriting any states ahead
          * of the curernt index for the `undo` case.
          *
+         * Slots left behind by undone moves are reused rather than
+         * reconstructed, and only the irreversible fields are copied.
+         *
+         * @param move
          * @return State&
          */
-        State &push_state();
+        State &push_state(Move move);
+
+        /**
+         * @brief Move the pieces of a state's move on the board.
+         *
+         * Used by `redo`, where the keys of the state are already known.
+         *
+         * @param state
+         */
+        void replay(const State &state);
+
+        /**
+         * @brief Fold the states below the current one into the game history,
+         * making the current state the root of the stack.
+         *
+         */
+        void rebase();
 
       public:
-        Position(std::string fen = DEFAULT_BOARD_FEN, Hasher hasher = Hasher());
+        Position(std::string fen = DEFAULT_BOARD_FEN);
+
+        /**
+         * @brief Copy a position rooted at its current state. Earlier states
+         * are only kept as hashes, so this is cheap enough to hand the
+         * position to a search thread.
+         *
+         * @param other
+         */
+        Position(const Position &other);
+        Position(Position &&other) = default;
+
+        Position &operator=(const Position &other);
+        Position &operator=(Position &&other) = default;
 
         /**
          * @brief Get the FEN string of the current game state.
@@ -48,6 +97,20 @@ namespace Brainiac {
          */
         Hash hash() const;
 
+        /**
+         * @brief Get the pawn structure hash of the current game state.
+         *
+         * @return Hash
+         */
+        Hash pawn_hash() const;
+
+        /**
+         * @brief Get the material signature hash of the current game state.
+         *
+         * @return Hash
+         */
+        Hash material_hash() const;
+
         /**
          * @brief Get the current board state.
          *
@@ -63,12 +126,52 @@ namespace Brainiac {
         Color turn() const;
 
         /**
-         * @brief Get the move list for the current turn.
+         * @brief Get the move list for the current turn. This is generated on
+         * first access and cached until the next move.
          *
          * @return const MoveList&
          */
         const MoveList &moves() const;
 
+        /**
+         * @brief Generate the legal moves of a category for the current turn
+         * into a separate list, without touching the cached move list.
+         *
+         * @param gen
+         * @param moves
+         */
+        void moves(GenType gen, MoveList &moves) const;
+
+        /**
+         * @brief Test if a move could be played in the current position,
+         * ignoring whether it leaves the king in check. This is cheap enough
+         * to validate a hash move without generating any moves.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_pseudo_legal(Move move) const;
+
+        /**
+         * @brief Test if a pseudo-legal move keeps the king out of check.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_legal(Move move) const;
+
+        /**
+         * @brief Test if a legal move checks the opponent king, without
+         * making it.
+         *
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool gives_check(Move move) const;
+
         /**
          * @brief Get the current set of castling rights.
          *
@@ -122,6 +225,26 @@ namespace Brainiac {
          */
         bool is_draw() const;
 
+        /**
+         * @brief Test if the game is a draw by stalemate, the fifty-move rule
+         * or bare kings, leaving out repetitions.
+         *
+         * @return true
+         * @return false
+         */
+        bool is_rule_draw() const;
+
+        /**
+         * @brief Test if the position repeats an earlier one since the last
+         * irreversible move. A single repeat of a state made after the root
+         * of the stack counts, while positions at or before the root must
+         * have occurred twice.
+         *
+         * @return true
+         * @return false
+         */
+        bool is_repetition() const;
+
         /**
          * @brief Test if the position is the initial state.
          *
@@ -149,6 +272,10 @@ namespace Brainiac {
         /**
          * @brief Make a move. This assumes moves are legal.
          *
+         * At most `MAX_DEPTH` moves and skips can be made past the root, as
+         * the state stack is sized for the deepest search. Use `play` for
+         * game moves.
+         *
          * @param move
          */
         void make(Move move);
@@ -166,11 +293,19 @@ namespace Brainiac {
         void redo();
 
         /**
-         * @brief Skip the current turn.
+         * @brief Skip the current turn. This uses up a state like `make`.
          *
          */
         void skip();
 
+        /**
+         * @brief Play a move in the game. Unlike `make`, this cannot be undone
+         * and does not use up the state stack.
+         *
+         * @param move
+         */
+        void play(Move move);
+
         /**
          * @brief Find a legal move from given src and dst square pairings.
          *
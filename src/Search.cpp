@@ -1,101 +1,28 @@
 #include "Search.hpp"
 
 namespace Brainiac {
+    /**
+     * @brief Get the number of workers used to clear the tables. Clearing
+     * happens between searches, so it uses every hardware thread rather than
+     * the Threads option.
+     *
+     * @return unsigned
+     */
+    static unsigned clear_threads() {
+        return std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
     Search::Search() {
+        _searching = false;
         _running = false;
+        _timeout = false;
+        set_threads(1);
 
         _on_bestmove = [](Move) {};
         _on_iterative = [](IterativeInfo) {};
         _on_pv = [](PVInfo) {};
     }
 
-    Value Search::see_target(Position &position, Square target) {
-        const Board &board = position.board();
-        const MoveList &moves = position.moves();
-
-        Piece victim = board.get(target);
-        if (victim == Piece::Empty) {
-            return 0;
-        }
-
-        Value value = 0;
-        Value mvv = std::abs(PIECE_WEIGHTS[victim]);
-        Value lva = MAX_VALUE;
-
-        Move best_move = moves[0];
-        for (Move move : moves) {
-            if (move.dst() != target) continue;
-
-            Piece attacker = board.get(move.src());
-            Value attacker_value = std::abs(PIECE_WEIGHTS[attacker]);
-            if (attacker_value < lva) {
-                lva = attacker_value;
-                best_move = move;
-            }
-        }
-
-        if (lva != MAX_VALUE) {
-            position.make(best_move);
-            value = std::max(0, mvv - see_target(position, target));
-            position.undo();
-        }
-
-        return value;
-    }
-
-    MoveValue Search::evaluate_capture(Position &position, Move move) {
-        const Board &board = position.board();
-        Piece victim = board.get(move.dst());
-
-        position.make(move);
-        Value value =
-            std::abs(PIECE_WEIGHTS[victim]) - see_target(position, move.dst());
-        position.undo();
-        return value;
-    }
-
-    MoveValue Search::evaluate_move(Position &position, Move move, Node node) {
-        // Prioritize hash moves
-        bool node_type = node.type != NodeType::Invalid;
-        bool node_move = node.move == move;
-        bool node_hash = node.hash == position.hash();
-        if (node_type && node_move && node_hash) {
-            return MAX_MOVE_VALUE;
-        }
-
-        // Prioritize moves with higher history heuristic
-        MoveValue value = _htable.get(position, move);
-
-        // Prioritize non-quiet moves
-        // Also, prioritize queen and knight promotions over all others
-        switch (move.type()) {
-        case MoveType::Capture:
-            value += 40 + evaluate_capture(position, move);
-            break;
-        case MoveType::QueenPromoCapture:
-        case MoveType::KnightPromoCapture:
-            value += 50 + evaluate_capture(position, move);
-            break;
-        case MoveType::EnPassant:
-            value += 20;
-            break;
-        case MoveType::QueenPromo:
-        case MoveType::KnightPromo:
-            value += 20;
-            break;
-        case MoveType::KingCastle:
-        case MoveType::QueenCastle:
-            value += 10;
-            break;
-        case MoveType::PawnDouble:
-            value += 10;
-            break;
-        default:
-            break;
-        }
-        return value;
-    }
-
     bool Search::can_reduce_move(Move move, MoveValue value) {
         MoveType type = move.type();
         switch (type) {
@@ -110,32 +37,61 @@ namespace Brainiac {
         }
     }
 
-    Value Search::negamax(Position &position,
+    Value Search::evaluate_position(SearchThread &thread) {
+        return evaluate(thread.position,
+                        thread.ptable,
+                        _ecache,
+                        &thread.ecache_stats);
+    }
+
+    Value Search::evaluate_static(SearchThread &thread) {
+        return Brainiac::evaluate_static(thread.position,
+                                         thread.ptable,
+                                         _ecache,
+                                         &thread.ecache_stats);
+    }
+
+    Value Search::negamax(SearchThread &thread,
                           Move prev,
                           Depth depth,
                           Depth ply,
                           Value alpha,
                           Value beta,
                           bool qsearch) {
+        Position &position = thread.position;
+
         // Clear the PV at this ply
-        _pvtable.clear(ply);
+        thread.pvtable.clear(ply);
 
-        // Time management
-        Seconds elapsed = time() - _start_time;
-        _timeout = elapsed >= _limit_time && _limit_time.count() >= 0;
+        // Time management is owned by the main thread
+        if (thread.id == 0) {
+            Seconds elapsed = time() - _start_time;
+            if (elapsed >= _limit_time && _limit_time.count() >= 0) {
+                _timeout = true;
+            }
+        }
         if (!_running || _timeout) return 0;
 
-        // Update visited statistics
-        _negamax_visited += !qsearch;
-        _qsearch_visited += qsearch;
+        // The state stack and the per-ply tables end at MAX_DEPTH
+        if (ply >= MAX_DEPTH - 1) return evaluate_position(thread);
+
+        // Update visited statistics, only this thread writes its counters
+        std::atomic<uint64_t> &visited =
+            qsearch ? thread.qsearch_visited : thread.negamax_visited;
+        visited.store(visited.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+
+        // Repetitions are draws, whatever score the table holds for the
+        // position reached along another path
+        if (position.is_repetition()) return 0;
 
         // Read the transposition table
         Value alpha_orig = alpha;
-        Node node = _tptable.get(position);
-        if (node.type != NodeType::Invalid && node.depth >= depth &&
-            node.hash == position.hash()) {
+        Node node = _tptable.get(position, &thread.tt_stats);
+        if (node.type != NodeType::Invalid && node.depth >= depth) {
             switch (node.type) {
             case NodeType::Exact:
+                TableStats::increment(thread.tt_stats.cutoffs);
                 return node.value;
             case NodeType::Lower:
                 alpha = std::max(alpha, node.value);
@@ -149,23 +105,28 @@ namespace Brainiac {
 
             // Early terminate
             if (alpha >= beta) {
+                TableStats::increment(thread.tt_stats.cutoffs);
                 return node.value;
             }
         }
 
+        // Terminal node, repetitions were ruled out above
+        if (position.is_checkmate()) return evaluate_checkmate(position);
+        if (position.is_rule_draw()) return 0;
+
         // Check standing pat score
+        Value stand_pat = MIN_VALUE;
         if (qsearch && !position.is_check()) {
-            Value stand_pat = evaluate(position);
+            stand_pat = evaluate_static(thread);
             if (stand_pat >= beta) return stand_pat;
             if (stand_pat > alpha) alpha = stand_pat;
         }
 
-        // Terminal node
-        if (position.is_checkmate() || position.is_draw() ||
-            (qsearch && (depth <= 0 || position.is_quiet()))) {
-            return evaluate(position);
+        // Leaf node
+        if (qsearch && depth <= 0) {
+            return evaluate_static(thread);
         } else if (!qsearch && depth <= 0) {
-            return negamax(position,
+            return negamax(thread,
                            prev,
                            MAX_QSEARCH_DEPTH,
                            ply + 1,
@@ -174,11 +135,12 @@ namespace Brainiac {
                            true);
         }
 
-        // Null move reduction
-        if (!position.is_check() && prev.type() != MoveType::Skip) {
+        // Null move reduction, the standing pat already bounds quiescence
+        if (!qsearch && !position.is_check() &&
+            prev.type() != MoveType::Skip) {
             Depth R = depth > 6 ? 4 : 3;
             position.skip();
-            Value score = -negamax(position,
+            Value score = -negamax(thread,
                                    Move(),
                                    depth - R - 1,
                                    ply + 1,
@@ -189,61 +151,33 @@ namespace Brainiac {
             if (score >= beta) {
                 depth -= 4;
                 if (depth <= 0) {
-                    return evaluate(position);
+                    return evaluate_static(thread);
                 }
             }
         }
 
-        // Compute moves to visit
-        MoveList moves;
-        for (Move move : position.moves()) {
-            switch (move.type()) {
-            case MoveType::Capture:
-            case MoveType::QueenPromoCapture:
-            case MoveType::KnightPromoCapture:
-            case MoveType::QueenPromo:
-            case MoveType::KnightPromo:
-                moves.add(move);
-                break;
-            default:
-                if (!qsearch) {
-                    moves.add(move);
-                }
-                break;
-            }
-        }
+        // Visit the hash move first, the picker drops it if it is not
+        // pseudo-legal here after a false hit
+        Move hash_move;
+        if (node.type != NodeType::Invalid) hash_move = node.move;
+        MovePicker picker(position,
+                          thread.htable,
+                          thread.killers,
+                          ply,
+                          hash_move,
+                          qsearch);
 
         // Non-terminal node
         Value value = MIN_VALUE;
-        MoveValue move_value = 0;
-        MoveIndex move_index = 0;
-        for (MoveIndex i = 0; i < moves.size(); i++) {
-            // Find highest scoring move
-            move_index = i;
-            move_value = evaluate_move(position, moves[move_index], node);
-            for (MoveIndex j = i + 1; j < moves.size(); j++) {
-                MoveValue j_value = evaluate_move(position, moves[j], node);
-                if (j_value > move_value) {
-                    move_index = j;
-                    move_value = j_value;
-                }
-            }
-            Move &move = moves[move_index];
+        Move best_move;
+        Move move;
+        bool picked = false;
+        for (MoveIndex i = 0; picker.next(move); i++) {
+            MoveValue move_value = picker.value();
+            picked = true;
 
             // Skip bad captures
-            if (qsearch) {
-                switch (move.type()) {
-                case MoveType::Capture:
-                    if (move_value < 40) continue;
-                    break;
-                case MoveType::QueenPromoCapture:
-                case MoveType::KnightPromoCapture:
-                    if (move_value < 50) continue;
-                    break;
-                default:
-                    break;
-                }
-            }
+            if (qsearch && !see_ge(position, move, 0)) continue;
 
             // Compute depth reduction
             Depth R = (depth >= 3 && i > 3 && !position.is_check() &&
@@ -254,7 +188,7 @@ namespace Brainiac {
 
             // Evaluate subtree
             position.make(move);
-            Value score = -negamax(position,
+            Value score = -negamax(thread,
                                    move,
                                    depth - R - 1 + E,
                                    ply + 1,
@@ -263,7 +197,7 @@ namespace Brainiac {
                                    qsearch);
             if (R && score > alpha) {
                 // Fail-low, do full re-search
-                score = -negamax(position,
+                score = -negamax(thread,
                                  move,
                                  depth - 1 + E,
                                  ply + 1,
@@ -271,23 +205,30 @@ namespace Brainiac {
                                  -alpha,
                                  qsearch);
             }
-            value = std::max(value, score);
+            if (score > value) {
+                value = score;
+                best_move = move;
+            }
             alpha = std::max(alpha, value);
             position.undo();
 
             // Early terminate
             if (alpha >= beta) {
                 if (_running && !_timeout && !qsearch) {
-                    _htable.set(position, move, depth);
-                    _pvtable.update(ply, move);
+                    thread.htable.set(position, move, depth);
+                    if (!is_noisy(move)) {
+                        thread.killers.set(ply, move);
+                    }
+                    thread.pvtable.update(ply, move);
                 }
                 break;
             }
-
-            // Swap with current index to sort
-            std::swap(move, moves[i]);
         }
 
+        // Quiescence search picks only noisy moves, without any the
+        // position is quiet and keeps its standing pat score
+        if (qsearch && !picked && !position.is_check()) return stand_pat;
+
         // Update the transposition table
         if (_running && !_timeout && !qsearch) {
             NodeType type = NodeType::Exact;
@@ -296,64 +237,20 @@ namespace Brainiac {
             } else if (value >= beta) {
                 type = NodeType::Lower;
             } else {
-                _pvtable.update(ply, moves[move_index]);
+                thread.pvtable.update(ply, best_move);
             }
-            _tptable.set(position, type, depth, value, moves[move_index]);
+            _tptable.set(position,
+                         type,
+                         depth,
+                         value,
+                         best_move,
+                         &thread.tt_stats);
         }
         return value;
     }
 
-    void Search::reset() {
-        _tptable.clear();
-        _htable.clear();
-    }
-
-    void Search::set_iterative_callback(IterativeCallback callback) {
-        _on_iterative = callback;
-    };
-
-    void Search::set_pv_callback(PVCallback callback) { _on_pv = callback; };
-
-    void Search::set_bestmove_callback(BestMoveCallback callback) {
-        _on_bestmove = callback;
-    }
-
-    void Search::go(Position &position, SearchLimits limits) {
-        // A search is currently running
-        if (_running) return;
-        _running = true;
-
-        // Reset timer
-        _timeout = false;
-        _start_time = time();
-        if (limits.move_time.count()) {
-            _limit_time = limits.move_time;
-        } else {
-            // Compute time per move
-            Seconds increment = position.turn() == Color::White
-                                    ? limits.white_increment
-                                    : limits.black_increment;
-            _limit_time = position.turn() == Color::White ? limits.white_time
-                                                          : limits.black_time;
-            if (limits.moves_to_go) {
-                _limit_time /= limits.moves_to_go;
-            } else {
-                _limit_time /= 30;
-            }
-
-            // Apply increment
-            if (_limit_time >= increment) {
-                _limit_time += increment;
-            }
-
-            // Assume infinite time if no time was provided
-            if (!_limit_time.count()) {
-                _limit_time = Seconds(-1);
-            }
-        }
-
-        _negamax_visited = 0;
-        _qsearch_visited = 0;
+    Move Search::iterate(SearchThread &thread, SearchLimits limits) {
+        Position &position = thread.position;
 
         // Initialize info objects
         IterativeInfo iterative_info;
@@ -367,18 +264,19 @@ namespace Brainiac {
         Value beta = MAX_VALUE;
         Value value = MIN_VALUE;
 
-        Depth depth = 1;
+        // Stagger the helper threads so they search different depths
+        Depth depth = 1 + (thread.id & 1);
         while (depth <= limits.depth && value != WIN_VALUE) {
             MoveIndex best_index = 0;
             for (MoveIndex i = 0; i < moves.size(); i++) {
                 Move move = moves[i];
 
                 // Clear PV at this ply
-                _pvtable.clear(0);
+                thread.pvtable.clear(0);
 
                 // Evaluate the move
                 position.make(move);
-                Value score = -negamax(position, move, depth, 1, alpha, beta);
+                Value score = -negamax(thread, move, depth, 1, alpha, beta);
                 position.undo();
 
                 // Check for cut-off
@@ -387,25 +285,33 @@ namespace Brainiac {
                     value = score;
 
                     // Update the PV
-                    _pvtable.update(0, move);
+                    thread.pvtable.update(0, move);
 
                     // PV callback
-                    pv_info.depth = depth;
-                    pv_info.time = time() - _start_time;
-                    pv_info.nodes = _negamax_visited + _qsearch_visited;
-                    pv_info.value = value;
-                    pv_info.pv_length = _pvtable.get_length(0);
-                    for (unsigned i = 0; i < pv_info.pv_length; i++) {
-                        pv_info.pv[i] = _pvtable.get(0, i);
+                    if (thread.id == 0) {
+                        pv_info.depth = depth;
+                        pv_info.time = time() - _start_time;
+                        pv_info.nodes = nodes();
+                        pv_info.hashfull = _tptable.hashfull();
+                        pv_info.table = table_stats();
+                        pv_info.pawn_table = pawn_table_stats();
+                        pv_info.eval_cache = eval_cache_stats();
+                        pv_info.value = value;
+                        pv_info.pv_length = thread.pvtable.get_length(0);
+                        for (unsigned i = 0; i < pv_info.pv_length; i++) {
+                            pv_info.pv[i] = thread.pvtable.get(0, i);
+                        }
+                        _on_pv(pv_info);
                     }
-                    _on_pv(pv_info);
                 }
 
                 // Traversal callback
-                iterative_info.move = move;
-                iterative_info.move_number = i + 1;
-                iterative_info.depth = depth;
-                _on_iterative(iterative_info);
+                if (thread.id == 0) {
+                    iterative_info.move = move;
+                    iterative_info.move_number = i + 1;
+                    iterative_info.depth = depth;
+                    _on_iterative(iterative_info);
+                }
 
                 if (value >= WIN_VALUE || !_running || _timeout) {
                     break;
@@ -423,15 +329,203 @@ namespace Brainiac {
             depth++;
         }
 
-        // Best move callback
         if (moves.size()) {
-            _on_bestmove(moves[0]);
+            return moves[0];
+        }
+        return Move();
+    }
+
+    uint64_t Search::nodes() const {
+        uint64_t total = 0;
+        for (const std::unique_ptr<SearchThread> &thread : _threads) {
+            total += thread->negamax_visited.load(std::memory_order_relaxed);
+            total += thread->qsearch_visited.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    TableStats Search::table_stats() const {
+        TableStats total;
+        for (const std::unique_ptr<SearchThread> &thread : _threads) {
+            total += thread->tt_stats.load();
+        }
+        return total;
+    }
+
+    TableStats Search::pawn_table_stats() const {
+        TableStats total;
+        for (const std::unique_ptr<SearchThread> &thread : _threads) {
+            total += thread->ptable.stats();
+        }
+        return total;
+    }
+
+    TableStats Search::eval_cache_stats() const {
+        TableStats total;
+        for (const std::unique_ptr<SearchThread> &thread : _threads) {
+            total += thread->ecache_stats.load();
+        }
+        return total;
+    }
+
+    bool Search::set_threads(unsigned count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        count = std::clamp(count, 1U, MAX_THREADS);
+
+        _threads.resize(count);
+        for (unsigned i = 0; i < count; i++) {
+            if (!_threads[i]) {
+                _threads[i] = std::make_unique<SearchThread>();
+                _threads[i]->id = i;
+            }
+        }
+
+        // The calling thread runs the main search, the pool only the helpers
+        _pool.resize(count - 1);
+        return true;
+    }
+
+    unsigned Search::threads() const { return _threads.size(); }
+
+    std::size_t Search::hash_capacity() const { return _tptable.capacity(); }
+
+    unsigned Search::hashfull() const { return _tptable.hashfull(); }
+
+    bool Search::set_hash(std::size_t megabytes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        ThreadPool pool(clear_threads());
+        _tptable.resize(megabytes, pool);
+        return true;
+    }
+
+    bool Search::set_eval_cache(std::size_t megabytes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        _ecache.resize(megabytes);
+        return true;
+    }
+
+    void Search::reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return;
+        _tptable.next_generation();
+        for (std::unique_ptr<SearchThread> &thread : _threads) {
+            thread->htable.clear();
+            thread->killers.clear();
+        }
+    }
+
+    bool Search::clear_hash() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        ThreadPool pool(clear_threads());
+        _tptable.clear(pool);
+        return true;
+    }
+
+    bool Search::set_slider_indexing(SliderIndexing indexing) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        return Brainiac::set_slider_indexing(indexing);
+    }
+
+    bool Search::save_hash(const std::string &path) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        return _tptable.save(path);
+    }
+
+    bool Search::load_hash(const std::string &path) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        return _tptable.load(path);
+    }
+
+    void Search::set_iterative_callback(IterativeCallback callback) {
+        _on_iterative = callback;
+    };
+
+    void Search::set_pv_callback(PVCallback callback) { _on_pv = callback; };
+
+    void Search::set_bestmove_callback(BestMoveCallback callback) {
+        _on_bestmove = callback;
+    }
+
+    bool Search::start() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_searching) return false;
+        _searching = true;
+        _running = true;
+        return true;
+    }
+
+    void Search::run(Position &position, SearchLimits limits) {
+        // Reset timer
+        _timeout = false;
+        _start_time = time();
+        if (limits.move_time.count()) {
+            _limit_time = limits.move_time;
         } else {
-            _on_bestmove(Move());
+            // Compute time per move
+            Seconds increment = position.turn() == Color::White
+                                    ? limits.white_increment
+                                    : limits.black_increment;
+            _limit_time = position.turn() == Color::White ? limits.white_time
+                                                          : limits.black_time;
+            if (limits.moves_to_go) {
+                _limit_time /= limits.moves_to_go;
+            } else {
+                _limit_time /= 30;
+            }
+
+            // Apply increment
+            if (_limit_time >= increment) {
+                _limit_time += increment;
+            }
+
+            // Assume infinite time if no time was provided
+            if (!_limit_time.count()) {
+                _limit_time = Seconds(-1);
+            }
+        }
+
+        // Age the entries of previous searches
+        _tptable.next_generation();
+
+        // Give each thread its own copy of the root position
+        for (std::unique_ptr<SearchThread> &thread : _threads) {
+            thread->position = position;
+            thread->negamax_visited = 0;
+            thread->qsearch_visited = 0;
+            thread->tt_stats.reset();
+            thread->ptable.reset_stats();
+            thread->ecache_stats.reset();
+        }
+
+        // Launch the helper threads
+        for (unsigned i = 1; i < _threads.size(); i++) {
+            SearchThread &helper = *_threads[i];
+            _pool.submit(
+                [this, &helper, limits]() { iterate(helper, limits); });
         }
 
-        // Terminate the search
+        // The main thread decides the best move, then stops the helpers
+        Move best_move = iterate(*_threads[0], limits);
         _running = false;
+        _pool.wait();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _searching = false;
+        }
+
+        // Best move callback
+        _on_bestmove(best_move);
+    }
+
+    void Search::go(Position &position, SearchLimits limits) {
+        if (start()) run(position, limits);
     }
 
     void Search::stop() { _running = false; }
@@ -1,13 +1,22 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include "EvalCache.hpp"
 #include "History.hpp"
+#include "Killers.hpp"
+#include "MovePicker.hpp"
 #include "Numeric.hpp"
 #include "PVTable.hpp"
+#include "PawnTable.hpp"
 #include "Position.hpp"
+#include "ThreadPool.hpp"
 #include "Transpositions.hpp"
 #include "Utils.hpp"
 
@@ -18,6 +27,12 @@ namespace Brainiac {
      */
     constexpr Depth MAX_QSEARCH_DEPTH = 6;
 
+    /**
+     * @brief Maximum number of search threads.
+     *
+     */
+    constexpr unsigned MAX_THREADS = 256;
+
     /**
      * @brief Iterative deepening information.
      *
@@ -60,10 +75,34 @@ namespace Brainiac {
         Seconds time;
 
         /**
-         * @brief Total number of nodes traversed.
+         * @brief Total number of nodes traversed across all threads.
+         *
+         */
+        uint64_t nodes;
+
+        /**
+         * @brief Transposition table occupancy in permille.
+         *
+         */
+        unsigned hashfull;
+
+        /**
+         * @brief Transposition table counters across all threads.
+         *
+         */
+        TableStats table;
+
+        /**
+         * @brief Pawn table counters across all threads.
+         *
+         */
+        TableStats pawn_table;
+
+        /**
+         * @brief Evaluation cache counters across all threads.
          *
          */
-        unsigned nodes;
+        TableStats eval_cache;
 
         /**
          * @brief Estimated valuation.
@@ -156,55 +195,114 @@ namespace Brainiac {
      */
     using PVCallback = std::function<void(PVInfo &)>;
 
+    /**
+     * @brief State owned by a single search thread. Lazy SMP helpers each get
+     * their own copy of the position and move ordering tables, and only
+     * communicate through the shared transposition table.
+     *
+     */
+    struct SearchThread {
+        /**
+         * @brief Thread index. The main thread is 0.
+         *
+         */
+        unsigned id;
+
+        /**
+         * @brief Private copy of the root position.
+         *
+         */
+        Position position;
+
+        /**
+         * @brief History heuristic table.
+         *
+         */
+        History htable;
+
+        /**
+         * @brief Killer move table.
+         *
+         */
+        Killers killers;
+
+        /**
+         * @brief Principal variation table.
+         *
+         */
+        PVTable pvtable;
+
+        /**
+         * @brief Pawn structure cache.
+         *
+         */
+        PawnTable ptable;
+
+        /**
+         * @brief Evaluation cache counters for this thread.
+         *
+         */
+        TableStats ecache_stats;
+
+        /**
+         * @brief Number of negamax nodes visited.
+         *
+         */
+        std::atomic<uint64_t> negamax_visited;
+
+        /**
+         * @brief Number of quiescence nodes visited.
+         *
+         */
+        std::atomic<uint64_t> qsearch_visited;
+
+        /**
+         * @brief Transposition table counters for this thread.
+         *
+         */
+        TableStats tt_stats;
+    };
+
     /**
      * @brief Search engine.
      *
      */
     class Search {
         Transpositions _tptable;
-        History _htable;
-        PVTable _pvtable;
-
+        EvalCache _ecache;
+        std::vector<std::unique_ptr<SearchThread>> _threads;
+        ThreadPool _pool;
+
+        // _searching spans a whole search and guards the tables and threads
+        // under _mutex, _running is the stop signal polled by the threads
+        std::mutex _mutex;
+        bool _searching;
         std::atomic_bool _running;
+        std::atomic_bool _timeout;
 
-        bool _timeout;
         Seconds _start_time;
         Seconds _limit_time;
 
-        unsigned _negamax_visited;
-        unsigned _qsearch_visited;
-
         BestMoveCallback _on_bestmove;
         IterativeCallback _on_iterative;
         PVCallback _on_pv;
 
         /**
-         * @brief Static exchange evaluation on a target square.
+         * @brief Evaluate the position of a thread through its caches.
          *
-         * @param position
-         * @param target
-         * @param pos
+         * @param thread
          * @return Value
          */
-        Value see_target(Position &position, Square target);
+        Value evaluate_position(SearchThread &thread);
 
         /**
-         * @brief Evaluate a capture move.
+         * @brief Evaluate the position of a thread through its caches, once
+         * checkmate and draws are ruled out.
          *
-         * @param move
-         * @param pos
-         * @return MoveValue
-         */
-        MoveValue evaluate_capture(Position &position, Move move);
-
-        /**
-         * @brief Compute the move value for ordering
-         *
-         * @param move
-         * @param node
-         * @return MoveValue
+         * @param thread
+         * @return Value
          */
-        MoveValue evaluate_move(Position &position, Move move, Node node);
+        Value evaluate_static(SearchThread &thread);
 
         /**
          * @brief Check if a move can be reduced.
@@ -219,7 +317,7 @@ namespace Brainiac {
         /**
          * @brief Recursive negamax algorithm.
          *
-         * @param position
+         * @param thread
          * @param prev
          * @param depth
          * @param ply
@@ -228,7 +326,7 @@ namespace Brainiac {
          * @param qsearch
          * @return Value
          */
-        Value negamax(Position &position,
+        Value negamax(SearchThread &thread,
                       Move prev,
                       Depth depth,
                       Depth ply,
@@ -236,15 +334,142 @@ namespace Brainiac {
                       Value beta = MAX_VALUE,
                       bool qsearch = false);
 
+        /**
+         * @brief Iterative deepening loop run by each search thread. Only the
+         * main thread reports progress through the callbacks.
+         *
+         * @param thread
+         * @param limits
+         * @return Move
+         */
+        Move iterate(SearchThread &thread, SearchLimits limits);
+
+        /**
+         * @brief Get the total number of nodes visited by all threads.
+         *
+         * @return uint64_t
+         */
+        uint64_t nodes() const;
+
       public:
         Search();
 
         /**
-         * @brief Reset the search state.
+         * @brief Set the number of search threads. Ignored while a search is
+         * running.
+         *
+         * @param count
+         * @return true if the threads were changed
+         */
+        bool set_threads(unsigned count);
+
+        /**
+         * @brief Get the number of search threads.
+         *
+         * @return unsigned
+         */
+        unsigned threads() const;
+
+        /**
+         * @brief Get the transposition table counters summed across all
+         * threads for the last search.
+         *
+         * @return TableStats
+         */
+        TableStats table_stats() const;
+
+        /**
+         * @brief Get the pawn table counters summed across all threads for
+         * the last search.
+         *
+         * @return TableStats
+         */
+        TableStats pawn_table_stats() const;
+
+        /**
+         * @brief Get the evaluation cache counters summed across all threads
+         * for the last search.
+         *
+         * @return TableStats
+         */
+        TableStats eval_cache_stats() const;
+
+        /**
+         * @brief Get the number of entries in the transposition table.
+         *
+         * @return std::size_t
+         */
+        std::size_t hash_capacity() const;
+
+        /**
+         * @brief Get the transposition table occupancy in permille.
+         *
+         * @return unsigned
+         */
+        unsigned hashfull() const;
+
+        /**
+         * @brief Resize the transposition table. Ignored while a search is
+         * running.
+         *
+         * @param megabytes
+         * @return true if the table was resized
+         */
+        bool set_hash(std::size_t megabytes);
+
+        /**
+         * @brief Resize the evaluation cache. Ignored while a search is
+         * running.
+         *
+         * @param megabytes
+         * @return true if the cache was resized
+         */
+        bool set_eval_cache(std::size_t megabytes);
+
+        /**
+         * @brief Reset the search state for a new game.
+         *
+         * Transposition entries are aged by starting a new generation rather
+         * than cleared. Ignored while a search is running.
          *
          */
         void reset();
 
+        /**
+         * @brief Clear the transposition table. Ignored while a search is
+         * running.
+         *
+         * @return true if the table was cleared
+         */
+        bool clear_hash();
+
+        /**
+         * @brief Refill the slider attack tables with an indexing method.
+         * Ignored while a search is running.
+         *
+         * @param indexing
+         * @return true if the tables were refilled
+         */
+        bool set_slider_indexing(SliderIndexing indexing);
+
+        /**
+         * @brief Save the transposition table to a file. Ignored while a
+         * search is running.
+         *
+         * @param path
+         * @return true if the file was written
+         */
+        bool save_hash(const std::string &path);
+
+        /**
+         * @brief Load the transposition table from a file. Ignored while a
+         * search is running.
+         *
+         * @param path
+         * @return true if the table was loaded
+         */
+        bool load_hash(const std::string &path);
+
         /**
          * @brief Set the iterative deepening callback.
          *
@@ -266,6 +491,25 @@ namespace Brainiac {
          */
         void set_bestmove_callback(BestMoveCallback callback);
 
+        /**
+         * @brief Mark a search as running. From here on, options are
+         * rejected and `stop` ends the search, even if `run` has not been
+         * called yet on the search thread.
+         *
+         * @return true
+         * @return false A search is already running.
+         */
+        bool start();
+
+        /**
+         * @brief Calculate the next viable move for the current turn. This
+         * must follow a successful call to `start`.
+         *
+         * @param position
+         * @param limits
+         */
+        void run(Position &position, SearchLimits limits);
+
         /**
          * @brief Calculate the next viable move for the current turn.
          *
@@ -274,7 +518,6 @@ namespace Brainiac {
          *
          * @param position
          * @param limits
-         * @return Move
          */
         void go(Position &position, SearchLimits limits);
 
@@ -1,6 +1,114 @@
+#include <mutex>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
 #include "Sliders.hpp"
 
 namespace Brainiac {
     std::array<SlidingMoveTable, 64> ROOK_ATTACK_TABLES = {};
     std::array<SlidingMoveTable, 64> BISHOP_ATTACK_TABLES = {};
+
+    std::array<Bitboard, ROOK_ATTACK_TABLE_SIZE> ROOK_ATTACKS = {};
+    std::array<Bitboard, BISHOP_ATTACK_TABLE_SIZE> BISHOP_ATTACKS = {};
+
+    SliderIndexing SLIDER_INDEXING = SliderIndexing::IndexMagic;
+
+    void init_rook_tables(
+        std::array<SlidingMoveTable, 64> &tables,
+        std::array<Bitboard, ROOK_ATTACK_TABLE_SIZE> &attacks) {
+        unsigned offset = 0;
+        for (unsigned i = 0; i < 64; i++) {
+            Bitboard bitboard = 1ULL << i;
+            Bitboard block_mask = rook_block_mask(i);
+
+            SlidingMoveTable &table = tables[i];
+            table.block_mask = block_mask;
+            table.shift = count_set_bitboard(block_mask);
+            table.magic = ROOK_MAGICS[i];
+            table.move_masks = attacks.data() + offset;
+            offset += 1U << table.shift;
+
+            // Visit every subset of the block mask (Carry-Rippler)
+            Bitboard blockers = 0;
+            do {
+                Bitboard index = slider_index(table, blockers);
+                table.move_masks[index] = get_n_mask(bitboard, blockers) |
+                                          get_s_mask(bitboard, blockers) |
+                                          get_e_mask(bitboard, blockers) |
+                                          get_w_mask(bitboard, blockers);
+                blockers = (blockers - block_mask) & block_mask;
+            } while (blockers);
+        }
+    }
+
+    void init_bishop_tables(
+        std::array<SlidingMoveTable, 64> &tables,
+        std::array<Bitboard, BISHOP_ATTACK_TABLE_SIZE> &attacks) {
+        unsigned offset = 0;
+        for (unsigned i = 0; i < 64; i++) {
+            Bitboard bitboard = 1ULL << i;
+            Bitboard block_mask = bishop_block_mask(i);
+
+            SlidingMoveTable &table = tables[i];
+            table.block_mask = block_mask;
+            table.shift = count_set_bitboard(block_mask);
+            table.magic = BISHOP_MAGICS[i];
+            table.move_masks = attacks.data() + offset;
+            offset += 1U << table.shift;
+
+            // Visit every subset of the block mask (Carry-Rippler)
+            Bitboard blockers = 0;
+            do {
+                Bitboard index = slider_index(table, blockers);
+                table.move_masks[index] = get_ne_mask(bitboard, blockers) |
+                                          get_se_mask(bitboard, blockers) |
+                                          get_sw_mask(bitboard, blockers) |
+                                          get_nw_mask(bitboard, blockers);
+                blockers = (blockers - block_mask) & block_mask;
+            } while (blockers);
+        }
+    }
+
+    bool cpu_has_pext() {
+#if defined(__x86_64__) && defined(__GNUC__)
+        return __builtin_cpu_supports("bmi2");
+#else
+        return false;
+#endif
+    }
+
+    bool cpu_has_fast_pext() {
+        if (!cpu_has_pext()) return false;
+#if defined(__x86_64__) && defined(__GNUC__)
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        __get_cpuid(0, &eax, &ebx, &ecx, &edx);
+        bool amd = ebx == 0x68747541; // "Auth" of "AuthenticAMD"
+        __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+        unsigned family = (eax >> 8) & 0xf;
+        if (family == 0xf) family += (eax >> 20) & 0xff;
+        return !amd || family >= 0x19;
+#else
+        return false;
+#endif
+    }
+
+    bool set_slider_indexing(SliderIndexing indexing) {
+        if (indexing == SliderIndexing::IndexPext && !cpu_has_pext()) {
+            return false;
+        }
+        SLIDER_INDEXING = indexing;
+        init_rook_tables(ROOK_ATTACK_TABLES, ROOK_ATTACKS);
+        init_bishop_tables(BISHOP_ATTACK_TABLES, BISHOP_ATTACKS);
+        return true;
+    }
+
+    void init_slider_tables() {
+        static std::once_flag initialized;
+        std::call_once(initialized, [] {
+            set_slider_indexing(cpu_has_fast_pext() ? SliderIndexing::IndexPext
+                                               : SliderIndexing::IndexMagic);
+        });
+    }
 } // namespace Brainiac
\ No newline at end of file
@@ -11,14 +11,74 @@ namespace Brainiac {
      * @brief Stores necessary information for fetching the moveset
      * of a sliding piece using magic bitboards.
      *
+     * The move masks of every square are packed back to back in a single
+     * array per piece type (fancy magics), each square only reserving the
+     * 2^shift entries its magic index can reach.
+     *
      */
     struct SlidingMoveTable {
         unsigned shift;
         Bitboard block_mask;
         Bitboard magic;
-        std::array<Bitboard, 4096> move_masks;
+        Bitboard *move_masks;
     };
 
+    /**
+     * @brief Methods of mapping blocker occupancies to move mask indices.
+     *
+     * Magic indexing multiplies by a magic number and shifts. PEXT indexing
+     * extracts the blocker bits directly with BMI2, and is only available if
+     * the CPU supports it.
+     *
+     */
+    enum SliderIndexing : uint8_t {
+        IndexMagic,
+        IndexPext,
+    };
+
+    /**
+     * @brief Indexing method the slider attack tables are filled with.
+     *
+     */
+    extern SliderIndexing SLIDER_INDEXING;
+
+    /**
+     * @brief Compute the move mask index of a blocker occupancy.
+     *
+     * @tparam I
+     * @param table
+     * @param occupied
+     * @return Bitboard
+     */
+    template <SliderIndexing I>
+    inline Bitboard slider_index(const SlidingMoveTable &table,
+                                 Bitboard occupied) {
+        if constexpr (I == SliderIndexing::IndexPext) {
+            return pext_bitboard(occupied, table.block_mask);
+        } else {
+            Bitboard blockers = occupied & table.block_mask;
+            return (blockers * table.magic) >> (64 - table.shift);
+        }
+    }
+
+    /**
+     * @brief Compute the move mask index of a blocker occupancy with the
+     * indexing method the tables are filled with. The method only changes
+     * between searches, so the branch is always predicted and the lookup
+     * stays inline.
+     *
+     * @param table
+     * @param occupied
+     * @return Bitboard
+     */
+    inline Bitboard slider_index(const SlidingMoveTable &table,
+                                 Bitboard occupied) {
+        if (SLIDER_INDEXING == SliderIndexing::IndexPext) {
+            return slider_index<SliderIndexing::IndexPext>(table, occupied);
+        }
+        return slider_index<SliderIndexing::IndexMagic>(table, occupied);
+    }
+
     /**
      * @brief Magic numbers for rook move masks.
      *
@@ -177,68 +237,118 @@ namespace Brainiac {
             flip_vertical_bitboard(antidiag_mask));
     }
 
-    constexpr std::array<SlidingMoveTable, 64> init_rook_tables() {
-        std::array<SlidingMoveTable, 64> result = {};
-        for (unsigned i = 0; i < 64; i++) {
-            Bitboard bitboard = 1ULL << i;
-
-            Bitboard rank_mask = SQUARE_RANKS[i] & ~(FILES[0] | FILES[7]);
-            Bitboard file_mask = SQUARE_FILES[i] & ~(RANKS[0] | RANKS[7]);
-            Bitboard block_mask = ~bitboard & (rank_mask | file_mask);
-
-            SlidingMoveTable &table = result[i];
-            table.block_mask = block_mask;
-            table.shift = count_set_bitboard(block_mask);
-            table.magic = ROOK_MAGICS[i];
-
-            unsigned count = (1 << table.shift);
-            for (unsigned j = 0; j < count; j++) {
-                Bitboard blockers = get_occupancy(j, table.shift, block_mask);
-                Bitboard index = (blockers * table.magic) >> (64 - table.shift);
-                table.move_masks[index] = get_n_mask(bitboard, blockers) |
-                                          get_s_mask(bitboard, blockers) |
-                                          get_e_mask(bitboard, blockers) |
-                                          get_w_mask(bitboard, blockers);
-            }
-        }
-        return result;
+    /**
+     * @brief Get the squares whose occupancy can block a rook on a square.
+     *
+     * @param sq
+     * @return constexpr Bitboard
+     */
+    constexpr Bitboard rook_block_mask(unsigned sq) {
+        Bitboard rank_mask = SQUARE_RANKS[sq] & ~(FILES[0] | FILES[7]);
+        Bitboard file_mask = SQUARE_FILES[sq] & ~(RANKS[0] | RANKS[7]);
+        return ~(1ULL << sq) & (rank_mask | file_mask);
     }
 
-    constexpr std::array<SlidingMoveTable, 64> init_bishop_tables() {
-        std::array<SlidingMoveTable, 64> result = {};
-        for (int i = 0; i < 64; i++) {
-            Bitboard bitboard = 1ULL << i;
-
-            Bitboard diagonal_mask = SQUARE_DIAGONALS[i];
-            Bitboard antidiag_mask = SQUARE_ANTI_DIAGONALS[i];
-            Bitboard end_ranks_mask = RANKS[0] | RANKS[7];
-            Bitboard end_files_mask = FILES[0] | FILES[7];
-
-            Bitboard block_mask = diagonal_mask | antidiag_mask;
-            block_mask &= ~(bitboard | end_ranks_mask | end_files_mask);
-
-            SlidingMoveTable &table = result[i];
-            table.block_mask = block_mask;
-            table.shift = count_set_bitboard(block_mask);
-            table.magic = BISHOP_MAGICS[i];
-
-            unsigned count = (1 << table.shift);
-            for (unsigned j = 0; j < count; j++) {
-                Bitboard blockers = get_occupancy(j, table.shift, block_mask);
-                Bitboard index = (blockers * table.magic) >> (64 - table.shift);
-                table.move_masks[index] = get_ne_mask(bitboard, blockers) |
-                                          get_se_mask(bitboard, blockers) |
-                                          get_sw_mask(bitboard, blockers) |
-                                          get_nw_mask(bitboard, blockers);
-            }
+    /**
+     * @brief Get the squares whose occupancy can block a bishop on a square.
+     *
+     * @param sq
+     * @return constexpr Bitboard
+     */
+    constexpr Bitboard bishop_block_mask(unsigned sq) {
+        Bitboard end_ranks_mask = RANKS[0] | RANKS[7];
+        Bitboard end_files_mask = FILES[0] | FILES[7];
+        Bitboard block_mask = SQUARE_DIAGONALS[sq] | SQUARE_ANTI_DIAGONALS[sq];
+        return block_mask & ~((1ULL << sq) | end_ranks_mask | end_files_mask);
+    }
+
+    /**
+     * @brief Count the packed move mask entries needed by all squares.
+     *
+     * @param block_mask Block mask function of the piece type.
+     * @return constexpr unsigned
+     */
+    constexpr unsigned attack_table_size(Bitboard (*block_mask)(unsigned)) {
+        unsigned size = 0;
+        for (unsigned i = 0; i < 64; i++) {
+            size += 1U << count_set_bitboard(block_mask(i));
         }
-        return result;
+        return size;
     }
 
+    constexpr unsigned ROOK_ATTACK_TABLE_SIZE =
+        attack_table_size(rook_block_mask);
+    constexpr unsigned BISHOP_ATTACK_TABLE_SIZE =
+        attack_table_size(bishop_block_mask);
+
+    /**
+     * @brief Fill the rook attack tables in place.
+     *
+     * @param tables
+     * @param attacks Packed move masks referenced by the tables.
+     */
+    void init_rook_tables(
+        std::array<SlidingMoveTable, 64> &tables,
+        std::array<Bitboard, ROOK_ATTACK_TABLE_SIZE> &attacks);
+
     /**
-     * @brief Attack tables for sliding pieces.
+     * @brief Fill the bishop attack tables in place.
+     *
+     * @param tables
+     * @param attacks Packed move masks referenced by the tables.
+     */
+    void init_bishop_tables(
+        std::array<SlidingMoveTable, 64> &tables,
+        std::array<Bitboard, BISHOP_ATTACK_TABLE_SIZE> &attacks);
+
+    /**
+     * @brief Attack tables for sliding pieces. These have static storage and
+     * are filled in place by `init_slider_tables`.
      *
      */
     extern std::array<SlidingMoveTable, 64> ROOK_ATTACK_TABLES;
     extern std::array<SlidingMoveTable, 64> BISHOP_ATTACK_TABLES;
+
+    /**
+     * @brief Packed move masks of all squares for sliding pieces.
+     *
+     */
+    extern std::array<Bitboard, ROOK_ATTACK_TABLE_SIZE> ROOK_ATTACKS;
+    extern std::array<Bitboard, BISHOP_ATTACK_TABLE_SIZE> BISHOP_ATTACKS;
+
+    /**
+     * @brief Test if the CPU supports the BMI2 `pext` instruction.
+     *
+     * @return true
+     * @return false
+     */
+    bool cpu_has_pext();
+
+    /**
+     * @brief Test if the CPU runs `pext` fast enough to prefer it over
+     * magics. AMD CPUs before Zen 3 (family 0x19) support BMI2 but
+     * microcode `pext`, taking tens of cycles depending on the mask.
+     *
+     * @return true
+     * @return false
+     */
+    bool cpu_has_fast_pext();
+
+    /**
+     * @brief Refill the slider attack tables with an indexing method. This
+     * must not be called while other threads generate moves.
+     *
+     * @param indexing
+     * @return true
+     * @return false Indexing method is not supported by the CPU.
+     */
+    bool set_slider_indexing(SliderIndexing indexing);
+
+    /**
+     * @brief Fill the slider attack tables, using PEXT indexing if the CPU
+     * runs it fast. Only the first call does any work, and it is safe to call
+     * from several threads at once.
+     *
+     */
+    void init_slider_tables();
 } // namespace Brainiac
\ No newline at end of file
@@ -3,7 +3,7 @@
 namespace Brainiac {
     State::State() {}
 
-    State::State(std::string fen, Hasher &hasher) {
+    State::State(std::string fen, Board &board) : captured(Piece::Empty) {
         std::vector<std::string> fields = tokenize(fen, ' ');
         int row = 7;
         int col = 0;
@@ -37,12 +37,35 @@ namespace Brainiac {
         turn = (fields[1][0] == 'w') ? Color::White : Color::Black;
         halfmoves = stoi(fields[4]);
         fullmoves = stoi(fields[5]);
+        null_plies = 0;
 
-        hash = hasher(board, castling, turn, ep_dst);
-        generate_moves();
+        hash = compute_hash(board, castling, turn, ep_dst);
+        pawn_hash = compute_pawn_hash(board);
+        material_hash = compute_material_hash(board);
+        generated = false;
+        has_legal = LegalMoves::LegalUnknown;
+        prepared = false;
+        detect_check(board);
     }
 
-    std::string State::fen(bool include_counters) const {
+    void State::inherit(const State &prev) {
+        castling = prev.castling;
+        ep_dst = prev.ep_dst;
+        turn = prev.turn;
+        check = prev.check;
+        halfmoves = prev.halfmoves;
+        fullmoves = prev.fullmoves;
+        null_plies = prev.null_plies + 1;
+        hash = prev.hash;
+        pawn_hash = prev.pawn_hash;
+        material_hash = prev.material_hash;
+        captured = Piece::Empty;
+        generated = false;
+        has_legal = LegalMoves::LegalUnknown;
+        prepared = false;
+    }
+
+    std::string State::fen(const Board &board, bool include_counters) const {
         std::string fen = "";
         for (int row = 7; row >= 0; row--) {
             int counter = 0;
@@ -89,53 +112,198 @@ namespace Brainiac {
         return fen;
     }
 
-    void State::print() const {
+    void State::print(const Board &board) const {
         if (turn == Color::White) std::cout << "White's turn.\n";
         else std::cout << "Black's turn.\n";
         board.print();
     }
 
-    void State::generate_moves() {
-        Color op = static_cast<Color>(!turn);
+    void State::generate_moves(const Board &board) const {
+        if (generated) return;
+        moves.clear();
+        generator(board).generate_prepared<GenType::GenAll>(moves);
+        generated = true;
+    }
+
+    void State::generate_moves(const Board &board,
+                               GenType gen,
+                               MoveList &moves) const {
+        MoveGen &gen_state = generator(board);
+        switch (gen) {
+        case GenType::GenAll:
+            gen_state.generate_prepared<GenType::GenAll>(moves);
+            break;
+        case GenType::GenNoisy:
+            gen_state.generate_prepared<GenType::GenNoisy>(moves);
+            break;
+        case GenType::GenQuiet:
+            gen_state.generate_prepared<GenType::GenQuiet>(moves);
+            break;
+        case GenType::GenEvasions:
+            gen_state.generate_prepared<GenType::GenEvasions>(moves);
+            break;
+        case GenType::GenQuietChecks:
+            gen_state.generate_prepared<GenType::GenQuietChecks>(moves);
+            break;
+        }
+    }
+
+    bool State::has_moves(const Board &board) const {
+        if (has_legal != LegalMoves::LegalUnknown) {
+            return has_legal == LegalMoves::LegalSome;
+        }
+
+        // The partial list is discarded by the next full generation
+        if (!generated) {
+            MoveGen &gen = generator(board);
+            moves.clear();
+            gen.generate_king(moves);
+            if (moves.size()) {
+                has_legal = LegalMoves::LegalSome;
+                return true;
+            }
+
+            gen.generate_others(moves);
+            generated = true;
+        }
+        has_legal =
+            moves.size() ? LegalMoves::LegalSome : LegalMoves::LegalNone;
+        return moves.size();
+    }
+
+    bool State::is_pseudo_legal(const Board &board, Move move) const {
+        return generator(board).is_pseudo_legal(move);
+    }
+
+    bool State::is_legal(const Board &board, Move move) const {
+        return generator(board).is_legal(move);
+    }
+
+    bool State::gives_check(const Board &board, Move move) const {
+        return generator(board).gives_check(move);
+    }
 
+    void State::detect_check(const Board &board) {
+        Color op = static_cast<Color>(!turn);
         Piece f_king = create_piece(PieceType::King, turn);
-        Piece f_pawn = create_piece(PieceType::Pawn, turn);
-        Piece f_rook = create_piece(PieceType::Rook, turn);
-        Piece f_knight = create_piece(PieceType::Knight, turn);
-        Piece f_bishop = create_piece(PieceType::Bishop, turn);
-        Piece f_queen = create_piece(PieceType::Queen, turn);
-
-        Piece o_king = create_piece(PieceType::King, op);
-        Piece o_pawn = create_piece(PieceType::Pawn, op);
-        Piece o_rook = create_piece(PieceType::Rook, op);
-        Piece o_knight = create_piece(PieceType::Knight, op);
-        Piece o_bishop = create_piece(PieceType::Bishop, op);
-        Piece o_queen = create_piece(PieceType::Queen, op);
-
-        MoveGen generator;
-        generator.friends = board.bitboard(turn);
+        Square king_sq = find_lsb_bitboard(board.bitboard(f_king));
+        check = is_attacked(
+            king_sq,
+            turn,
+            board.bitboard(Color::White) | board.bitboard(Color::Black),
+            board.bitboard(create_piece(PieceType::Pawn, op)),
+            board.bitboard(create_piece(PieceType::Knight, op)),
+            board.bitboard(create_piece(PieceType::Bishop, op)),
+            board.bitboard(create_piece(PieceType::Rook, op)),
+            board.bitboard(create_piece(PieceType::Queen, op)));
+    }
+
+    void State::detect_check(const Board &board, Move move) {
+        // Castling and en-passant move a second piece off its square
+        MoveType type = move.type();
+        if (type == MoveType::KingCastle || type == MoveType::QueenCastle ||
+            type == MoveType::EnPassant) {
+            detect_check(board);
+            return;
+        }
+
+        Color op = static_cast<Color>(!turn);
+        Square src_sq = move.src();
+        Square dst_sq = move.dst();
+        Bitboard king = board.bitboard(create_piece(PieceType::King, turn));
+        Square king_sq = find_lsb_bitboard(king);
+        Bitboard all =
+            board.bitboard(Color::White) | board.bitboard(Color::Black);
+
+        // Direct check by the moved piece
+        Bitboard attacks = 0;
+        switch (get_piece_type(board.get(dst_sq))) {
+        case PieceType::Pawn:
+            attacks = pawn_captures(dst_sq, op);
+            break;
+        case PieceType::Knight:
+            attacks = knight_attacks(dst_sq);
+            break;
+        case PieceType::Bishop:
+            attacks = bishop_attacks(dst_sq, 0, all);
+            break;
+        case PieceType::Rook:
+            attacks = rook_attacks(dst_sq, 0, all);
+            break;
+        case PieceType::Queen:
+            attacks = queen_attacks(dst_sq, 0, all);
+            break;
+        default:
+            break;
+        }
+        if (attacks & king) {
+            check = true;
+            return;
+        }
+
+        // Discovered check by a slider on the line through the source square
+        Bitboard src = SQUARES[src_sq];
+        Bitboard queens = board.bitboard(create_piece(PieceType::Queen, op));
+        if (rook_attacks(king_sq, 0, 0) & src) {
+            Bitboard rooks =
+                board.bitboard(create_piece(PieceType::Rook, op)) | queens;
+            check = rook_attacks(king_sq, 0, all) & rooks;
+        } else if (bishop_attacks(king_sq, 0, 0) & src) {
+            Bitboard bishops =
+                board.bitboard(create_piece(PieceType::Bishop, op)) | queens;
+            check = bishop_attacks(king_sq, 0, all) & bishops;
+        } else {
+            check = false;
+        }
+    }
+
+    /**
+     * @brief Load the piece bitboards of a position into a move generator,
+     * with the pieces of each side known at compile time.
+     *
+     * @tparam C Color of the side to move.
+     * @param generator
+     * @param board
+     */
+    template <Color C>
+    static void load_generator(MoveGen &generator, const Board &board) {
+        constexpr Color op = static_cast<Color>(!C);
+
+        generator.friends = board.bitboard(C);
         generator.enemies = board.bitboard(op);
         generator.all = generator.friends | generator.enemies;
 
-        generator.f_king = board.bitboard(f_king);
-        generator.f_pawn = board.bitboard(f_pawn);
-        generator.f_rook = board.bitboard(f_rook);
-        generator.f_knight = board.bitboard(f_knight);
-        generator.f_bishop = board.bitboard(f_bishop);
-        generator.f_queen = board.bitboard(f_queen);
+        generator.f_king = board.bitboard(create_piece(PieceType::King, C));
+        generator.f_pawn = board.bitboard(create_piece(PieceType::Pawn, C));
+        generator.f_rook = board.bitboard(create_piece(PieceType::Rook, C));
+        generator.f_knight =
+            board.bitboard(create_piece(PieceType::Knight, C));
+        generator.f_bishop =
+            board.bitboard(create_piece(PieceType::Bishop, C));
+        generator.f_queen = board.bitboard(create_piece(PieceType::Queen, C));
 
-        generator.o_king = board.bitboard(o_king);
-        generator.o_pawn = board.bitboard(o_pawn);
-        generator.o_rook = board.bitboard(o_rook);
-        generator.o_knight = board.bitboard(o_knight);
-        generator.o_bishop = board.bitboard(o_bishop);
-        generator.o_queen = board.bitboard(o_queen);
-
-        generator.ep_dst = ep_dst;
-        generator.turn = turn;
-        generator.castling = castling;
+        generator.o_king = board.bitboard(create_piece(PieceType::King, op));
+        generator.o_pawn = board.bitboard(create_piece(PieceType::Pawn, op));
+        generator.o_rook = board.bitboard(create_piece(PieceType::Rook, op));
+        generator.o_knight =
+            board.bitboard(create_piece(PieceType::Knight, op));
+        generator.o_bishop =
+            board.bitboard(create_piece(PieceType::Bishop, op));
+        generator.o_queen = board.bitboard(create_piece(PieceType::Queen, op));
+    }
 
-        moves.clear();
-        check = generator.generate(moves);
+    MoveGen &State::generator(const Board &board) const {
+        if (prepared) return movegen;
+        if (turn == Color::White) {
+            load_generator<Color::White>(movegen, board);
+        } else {
+            load_generator<Color::Black>(movegen, board);
+        }
+        movegen.ep_dst = ep_dst;
+        movegen.turn = turn;
+        movegen.castling = castling;
+        movegen.prepare();
+        prepared = true;
+        return movegen;
     }
 } // namespace Brainiac
\ No newline at end of file
@@ -15,12 +15,24 @@
 #include "Utils.hpp"
 
 namespace Brainiac {
+    /**
+     * @brief Whether any legal move exists, if it is known yet.
+     *
+     */
+    enum LegalMoves : uint8_t {
+        LegalUnknown,
+        LegalNone,
+        LegalSome,
+    };
+
     /**
      * @brief Represents discrete chronological game state. This allows forward
      * and backward movement in time (undo/redo moves).
      *
      * This stores information that is difficult to retrive during the
-     * undo operation (e.g., castling rights).
+     * undo operation (e.g., castling rights). The board itself is owned by the
+     * position and updated in place, so only the move and the piece it
+     * captured are recorded to restore it.
      *
      */
     struct State {
@@ -62,10 +74,55 @@ namespace Brainiac {
         Clock fullmoves;
 
         /**
-         * @brief Move set.
+         * @brief Plies since the last skipped turn. Repetitions are not
+         * counted across a skip.
          *
          */
-        MoveList moves;
+        Clock null_plies;
+
+        /**
+         * @brief Move that led to this state.
+         *
+         */
+        Move move;
+
+        /**
+         * @brief Piece captured by the move, including en-passant captures.
+         *
+         */
+        Piece captured;
+
+        /**
+         * @brief Move set, generated on first access.
+         *
+         */
+        mutable MoveList moves;
+
+        /**
+         * @brief Is the move set up to date?
+         *
+         */
+        mutable bool generated;
+
+        /**
+         * @brief Does the side to move have a legal move? Cached by
+         * `has_moves`, which may stop after generating the king moves.
+         *
+         */
+        mutable LegalMoves has_legal;
+
+        /**
+         * @brief Move generator with its masks computed, built on first
+         * access and shared by every generation category.
+         *
+         */
+        mutable MoveGen movegen;
+
+        /**
+         * @brief Is the move generator up to date?
+         *
+         */
+        mutable bool prepared;
 
         /**
          * @brief Hash value.
@@ -74,10 +131,16 @@ namespace Brainiac {
         Hash hash;
 
         /**
-         * @brief Board state.
+         * @brief Hash of the pawns of both colors.
+         *
+         */
+        Hash pawn_hash;
+
+        /**
+         * @brief Hash of the number of pieces of each kind.
          *
          */
-        Board board;
+        Hash material_hash;
 
         /**
          * @brief Initialize an empty state.
@@ -86,29 +149,122 @@ namespace Brainiac {
         State();
 
         /**
-         * @brief Initialize state from a FEN string.
+         * @brief Initialize state from a FEN string, placing its pieces on the
+         * board.
          *
          * @param fen
-         * @param hasher
+         * @param board
          */
-        State(std::string fen, Hasher &hasher);
+        State(std::string fen, Board &board);
+
+        /**
+         * @brief Copy the irreversible fields of the previous state, leaving
+         * the move list to be regenerated.
+         *
+         * @param prev
+         */
+        void inherit(const State &prev);
 
         /**
          * @brief Get the FEN string of the board.
          *
+         * @param board
+         * @param include_counters
          */
-        std::string fen(bool include_counters = true) const;
+        std::string fen(const Board &board, bool include_counters = true) const;
 
         /**
          * @brief Pretty print the state.
          *
+         * @param board
+         */
+        void print(const Board &board) const;
+
+        /**
+         * @brief Generate the moves for the specified turn, unless they are
+         * already cached.
+         *
+         * @param board
+         */
+        void generate_moves(const Board &board) const;
+
+        /**
+         * @brief Generate only the moves of a category into a separate list.
+         * The cached move list is left untouched.
+         *
+         * @param board
+         * @param gen
+         * @param moves
+         */
+        void generate_moves(const Board &board,
+                            GenType gen,
+                            MoveList &moves) const;
+
+        /**
+         * @brief Test if any legal move exists. This only generates king moves
+         * unless the king cannot move, and the result is cached.
+         *
+         * @param board
+         * @return true
+         * @return false
+         */
+        bool has_moves(const Board &board) const;
+
+        /**
+         * @brief Test if a move could be played by the side to move, ignoring
+         * whether it leaves the king in check.
+         *
+         * @param board
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_pseudo_legal(const Board &board, Move move) const;
+
+        /**
+         * @brief Test if a pseudo-legal move keeps the king out of check.
+         *
+         * @param board
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool is_legal(const Board &board, Move move) const;
+
+        /**
+         * @brief Test if a legal move checks the opponent king.
+         *
+         * @param board
+         * @param move
+         * @return true
+         * @return false
+         */
+        bool gives_check(const Board &board, Move move) const;
+
+        /**
+         * @brief Update the check flag without generating moves.
+         *
+         * @param board
+         */
+        void detect_check(const Board &board);
+
+        /**
+         * @brief Update the check flag after a move from the attacks of the
+         * moved piece and the sliders behind its source square.
+         *
+         * @param board
+         * @param move
          */
-        void print() const;
+        void detect_check(const Board &board, Move move);
 
+      private:
         /**
-         * @brief Generate the moves for the specified turn.
+         * @brief Get the move generator for the specified turn, initializing
+         * it and computing its masks unless already cached.
          *
+         * @param board
+         * @return MoveGen&
          */
-        void generate_moves();
+        MoveGen &generator(const Board &board) const;
     };
 } // namespace Brainiac
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include <utility>
+
+#include "StaticExchange.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Attacker types in order of increasing value.
+     *
+     */
+    static constexpr std::array<PieceType, 6> SEE_ORDER = {
+        PieceType::Pawn,
+        PieceType::Knight,
+        PieceType::Bishop,
+        PieceType::Rook,
+        PieceType::Queen,
+        PieceType::King,
+    };
+
+    /**
+     * @brief Promoted piece types, indexed from `MoveType::KnightPromo`.
+     *
+     */
+    static constexpr std::array<PieceType, 4> PROMOTION_TYPES = {
+        PieceType::Knight,
+        PieceType::Rook,
+        PieceType::Bishop,
+        PieceType::Queen,
+    };
+
+    /**
+     * @brief Get the piece type left on the destination square of a move.
+     *
+     * @param board
+     * @param move
+     * @return PieceType
+     */
+    static PieceType moved_type(const Board &board, Move move) {
+        MoveType type = move.type();
+        if (type >= MoveType::KnightPromo) {
+            return PROMOTION_TYPES[(type - MoveType::KnightPromo) & 3];
+        }
+        return static_cast<PieceType>(board.get(move.src()) % 6);
+    }
+
+    /**
+     * @brief Get the value captured by a move, including promotion gains.
+     *
+     * @param board
+     * @param move
+     * @return Value
+     */
+    static Value captured_value(const Board &board, Move move) {
+        MoveType type = move.type();
+        Value value = 0;
+        if (type == MoveType::EnPassant) {
+            value = SEE_VALUES[PieceType::Pawn];
+        } else if (board.get(move.dst()) != Piece::Empty) {
+            value = SEE_VALUES[board.get(move.dst()) % 6];
+        }
+        if (type >= MoveType::KnightPromo) {
+            value += SEE_VALUES[moved_type(board, move)] -
+                     SEE_VALUES[PieceType::Pawn];
+        }
+        return value;
+    }
+
+    /**
+     * @brief Get the occupancy after the moving piece (and an en-passant
+     * victim) leave the board.
+     *
+     * @param board
+     * @param move
+     * @param turn
+     * @return Bitboard
+     */
+    static Bitboard
+    exchange_occupancy(const Board &board, Move move, Color turn) {
+        Bitboard occupied =
+            board.bitboard(Color::White) | board.bitboard(Color::Black);
+        occupied ^= 1ULL << move.src();
+        if (move.type() == MoveType::EnPassant) {
+            int pawn_dir = ((1 - turn) * 2) - 1;
+            occupied ^= 1ULL << (move.dst() - (8 * pawn_dir));
+        }
+        return occupied;
+    }
+
+    /**
+     * @brief Find the least valuable piece among a set of attackers.
+     *
+     * @param board
+     * @param attackers
+     * @param color
+     * @return std::pair<Bitboard, PieceType> Single bit of the chosen
+     * attacker and its type.
+     */
+    static std::pair<Bitboard, PieceType>
+    least_valuable(const Board &board, Bitboard attackers, Color color) {
+        for (PieceType type : SEE_ORDER) {
+            Piece piece = create_piece(type, color);
+            Bitboard pieces = attackers & board.bitboard(piece);
+            if (pieces) return {get_lsb_bitboard(pieces), type};
+        }
+
+        // Unreachable for a nonempty set of attackers of this color
+        return {0, PieceType::King};
+    }
+
+    /**
+     * @brief Get the sliders that attack a square through the occupancy,
+     * revealing x-rays behind removed attackers.
+     *
+     * @param board
+     * @param sq
+     * @param occupied
+     * @return Bitboard
+     */
+    static Bitboard
+    slider_attackers(const Board &board, Square sq, Bitboard occupied) {
+        Bitboard queens = board.bitboard(Piece::WhiteQueen) |
+                          board.bitboard(Piece::BlackQueen);
+        Bitboard rooks = board.bitboard(Piece::WhiteRook) |
+                         board.bitboard(Piece::BlackRook) | queens;
+        Bitboard bishops = board.bitboard(Piece::WhiteBishop) |
+                           board.bitboard(Piece::BlackBishop) | queens;
+        return (rook_attacks(sq, 0, occupied) & rooks) |
+               (bishop_attacks(sq, 0, occupied) & bishops);
+    }
+
+    Bitboard attackers_to(const Board &board, Square sq, Bitboard occupied) {
+        Bitboard knights = board.bitboard(Piece::WhiteKnight) |
+                           board.bitboard(Piece::BlackKnight);
+        Bitboard kings = board.bitboard(Piece::WhiteKing) |
+                         board.bitboard(Piece::BlackKing);
+        Bitboard w_pawns = pawn_captures(sq, Color::Black) &
+                           board.bitboard(Piece::WhitePawn);
+        Bitboard b_pawns = pawn_captures(sq, Color::White) &
+                           board.bitboard(Piece::BlackPawn);
+        return w_pawns | b_pawns | (knight_attacks(sq) & knights) |
+               (king_attacks(sq) & kings) |
+               slider_attackers(board, sq, occupied);
+    }
+
+    Value see(const Position &position, Move move) {
+        MoveType type = move.type();
+        if (type == MoveType::KingCastle || type == MoveType::QueenCastle) {
+            return 0;
+        }
+
+        const Board &board = position.board();
+        Square dst = move.dst();
+        Color side = position.turn();
+
+        // Each capture can remove at most one of the 32 pieces
+        std::array<Value, 32> gain;
+        gain[0] = captured_value(board, move);
+        Value attacker = SEE_VALUES[moved_type(board, move)];
+
+        Bitboard occupied = exchange_occupancy(board, move, side);
+        Bitboard attackers = attackers_to(board, dst, occupied) & occupied;
+
+        unsigned depth = 0;
+        while (true) {
+            side = static_cast<Color>(!side);
+            Bitboard side_attackers = attackers & board.bitboard(side);
+            if (!side_attackers) break;
+
+            auto [from, type] = least_valuable(board, side_attackers, side);
+
+            // The king cannot recapture onto a defended square
+            Bitboard defenders = attackers & ~board.bitboard(side);
+            if (type == PieceType::King && defenders) break;
+
+            depth++;
+            gain[depth] = attacker - gain[depth - 1];
+
+            occupied ^= from;
+            attackers |= slider_attackers(board, dst, occupied);
+            attackers &= occupied;
+            attacker = SEE_VALUES[type];
+        }
+
+        // Either side may stand pat instead of continuing the exchange
+        while (depth) {
+            gain[depth - 1] = -std::max<Value>(-gain[depth - 1], gain[depth]);
+            depth--;
+        }
+        return gain[0];
+    }
+
+    bool see_ge(const Position &position, Move move, Value threshold) {
+        MoveType type = move.type();
+        if (type == MoveType::KingCastle || type == MoveType::QueenCastle) {
+            return 0 >= threshold;
+        }
+
+        const Board &board = position.board();
+        Square dst = move.dst();
+        Color side = position.turn();
+
+        // Fails even if the moved piece is captured for free
+        int swap = captured_value(board, move) - threshold;
+        if (swap < 0) return false;
+
+        // Succeeds even if the moved piece is lost
+        swap = SEE_VALUES[moved_type(board, move)] - swap;
+        if (swap <= 0) return true;
+
+        Bitboard occupied = exchange_occupancy(board, move, side);
+        Bitboard attackers = attackers_to(board, dst, occupied);
+
+        bool result = true;
+        while (true) {
+            side = static_cast<Color>(!side);
+            attackers &= occupied;
+
+            Bitboard side_attackers = attackers & board.bitboard(side);
+            if (!side_attackers) break;
+            result = !result;
+
+            auto [from, type] = least_valuable(board, side_attackers, side);
+
+            // The king only wins the square if it is no longer defended
+            if (type == PieceType::King) {
+                Bitboard defenders = attackers & ~board.bitboard(side);
+                return defenders ? !result : result;
+            }
+
+            swap = SEE_VALUES[type] - swap;
+            if (swap < result) break;
+
+            occupied ^= from;
+            attackers |= slider_attackers(board, dst, occupied);
+        }
+        return result;
+    }
+} // namespace Brainiac
\ No newline at end of file
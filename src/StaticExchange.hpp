@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+
+#include "Bitboard.hpp"
+#include "Board.hpp"
+#include "Evaluation.hpp"
+#include "Move.hpp"
+#include "MoveGen.hpp"
+#include "Numeric.hpp"
+#include "Position.hpp"
+
+namespace Brainiac {
+    /**
+     * @brief Piece values used by static exchange evaluation, indexed by
+     * piece type.
+     *
+     */
+    constexpr std::array<Value, 6> SEE_VALUES = {
+        PIECE_WEIGHTS[Piece::WhiteKing],
+        PIECE_WEIGHTS[Piece::WhitePawn],
+        PIECE_WEIGHTS[Piece::WhiteRook],
+        PIECE_WEIGHTS[Piece::WhiteKnight],
+        PIECE_WEIGHTS[Piece::WhiteBishop],
+        PIECE_WEIGHTS[Piece::WhiteQueen],
+    };
+
+    /**
+     * @brief Get the pieces of both colors that attack a square, given the
+     * occupancy of the board.
+     *
+     * @param board
+     * @param sq
+     * @param occupied
+     * @return Bitboard
+     */
+    Bitboard attackers_to(const Board &board, Square sq, Bitboard occupied);
+
+    /**
+     * @brief Static exchange evaluation of a move. Computes the material
+     * balance of the exchange on the destination square, assuming both sides
+     * recapture with their least valuable attacker and may stop at any time.
+     *
+     * Sliders behind an attacker are revealed as it is removed. Pins are
+     * ignored.
+     *
+     * @param position
+     * @param move
+     * @return Value
+     */
+    Value see(const Position &position, Move move);
+
+    /**
+     * @brief Test if the static exchange evaluation of a move is at least a
+     * threshold. This exits as soon as the outcome is decided.
+     *
+     * @param position
+     * @param move
+     * @param threshold
+     * @return true
+     * @return false
+     */
+    bool see_ge(const Position &position, Move move, Value threshold);
+} // namespace Brainiac
\ No newline at end of file
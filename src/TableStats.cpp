@@ -0,0 +1,39 @@
+#include "TableStats.hpp"
+
+namespace Brainiac {
+    TableStats TableStats::load() const {
+        // atomic_ref only takes non-const objects, but loading never writes
+        auto read = [](const uint64_t &counter) {
+            return std::atomic_ref<uint64_t>(const_cast<uint64_t &>(counter))
+                .load(std::memory_order_relaxed);
+        };
+        TableStats stats;
+        stats.probes = read(probes);
+        stats.hits = read(hits);
+        stats.cutoffs = read(cutoffs);
+        stats.collisions = read(collisions);
+        stats.overwrites = read(overwrites);
+        return stats;
+    }
+
+    void TableStats::reset() {
+        auto zero = [](uint64_t &counter) {
+            std::atomic_ref<uint64_t>(counter).store(0,
+                                                     std::memory_order_relaxed);
+        };
+        zero(probes);
+        zero(hits);
+        zero(cutoffs);
+        zero(collisions);
+        zero(overwrites);
+    }
+
+    TableStats &TableStats::operator+=(const TableStats &other) {
+        probes += other.probes;
+        hits += other.hits;
+        cutoffs += other.cutoffs;
+        collisions += other.collisions;
+        overwrites += other.overwrites;
+        return *this;
+    }
+} // namespace Brainiac
\ No newline at end of file
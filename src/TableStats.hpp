@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Brainiac {
+    /**
+     * @brief Hash table usage counters.
+     *
+     * Each search thread owns its own counters so that counting never
+     * contends on a shared cache line. They are only written by the owning
+     * thread but may be read by others, so all accesses are atomic. With a
+     * single writer, incrementing is a relaxed load and store rather than a
+     * locked read-modify-write.
+     *
+     */
+    struct TableStats {
+        /**
+         * @brief Number of lookups.
+         *
+         */
+        uint64_t probes = 0;
+
+        /**
+         * @brief Number of lookups that found the position.
+         *
+         */
+        uint64_t hits = 0;
+
+        /**
+         * @brief Number of hits whose value ended the search of a node.
+         *
+         */
+        uint64_t cutoffs = 0;
+
+        /**
+         * @brief Number of misses on a cluster full of other positions.
+         *
+         */
+        uint64_t collisions = 0;
+
+        /**
+         * @brief Number of stores that evicted another position.
+         *
+         */
+        uint64_t overwrites = 0;
+
+        /**
+         * @brief Increment a counter owned by the calling thread.
+         *
+         * @param counter
+         */
+        static void increment(uint64_t &counter) {
+            std::atomic_ref<uint64_t> ref(counter);
+            ref.store(ref.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Read a consistent copy of the counters.
+         *
+         * @return TableStats
+         */
+        TableStats load() const;
+
+        /**
+         * @brief Reset all counters to zero.
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Accumulate the counters of another set.
+         *
+         * @param other
+         * @return TableStats&
+         */
+        TableStats &operator+=(const TableStats &other);
+    };
+} // namespace Brainiac
\ No newline at end of file
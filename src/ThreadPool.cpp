@@ -0,0 +1,67 @@
+#include "ThreadPool.hpp"
+
+namespace Brainiac {
+    ThreadPool::ThreadPool(unsigned count) : _active(0), _stop(false) {
+        resize(count);
+    }
+
+    ThreadPool::~ThreadPool() { join(); }
+
+    void ThreadPool::work() {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _task_cv.wait(lock, [&]() { return _stop || _tasks.size(); });
+                if (_tasks.empty()) return;
+
+                task = std::move(_tasks.front());
+                _tasks.pop();
+                _active++;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _active--;
+                if (_tasks.empty() && !_active) _done_cv.notify_all();
+            }
+        }
+    }
+
+    void ThreadPool::join() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _task_cv.notify_all();
+        for (std::thread &worker : _workers) {
+            worker.join();
+        }
+        _workers.clear();
+        _stop = false;
+    }
+
+    void ThreadPool::resize(unsigned count) {
+        join();
+        for (unsigned i = 0; i < count; i++) {
+            _workers.emplace_back(&ThreadPool::work, this);
+        }
+    }
+
+    unsigned ThreadPool::size() const { return _workers.size(); }
+
+    void ThreadPool::submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push(std::move(task));
+        }
+        _task_cv.notify_one();
+    }
+
+    void ThreadPool::wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done_cv.wait(lock, [&]() { return _tasks.empty() && !_active; });
+    }
+} // namespace Brainiac
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Brainiac {
+    /**
+     * @brief Task run by a thread pool.
+     *
+     */
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Fixed set of worker threads that are kept alive between jobs.
+     *
+     */
+    class ThreadPool {
+        std::vector<std::thread> _workers;
+        std::queue<Task> _tasks;
+
+        std::mutex _mutex;
+        std::condition_variable _task_cv;
+        std::condition_variable _done_cv;
+
+        unsigned _active;
+        bool _stop;
+
+        /**
+         * @brief Worker loop.
+         *
+         */
+        void work();
+
+        /**
+         * @brief Stop and join all workers.
+         *
+         */
+        void join();
+
+      public:
+        /**
+         * @brief Construct a pool with a number of workers.
+         *
+         * @param count
+         */
+        ThreadPool(unsigned count = 1);
+        ~ThreadPool();
+
+        /**
+         * @brief Set the number of workers. Waits for pending tasks.
+         *
+         * @param count
+         */
+        void resize(unsigned count);
+
+        /**
+         * @brief Get the number of workers.
+         *
+         * @return unsigned
+         */
+        unsigned size() const;
+
+        /**
+         * @brief Queue a task to be run by a worker.
+         *
+         * @param task
+         */
+        void submit(Task task);
+
+        /**
+         * @brief Block until all submitted tasks have completed.
+         *
+         */
+        void wait();
+    };
+} // namespace Brainiac
@@ -1,33 +1,309 @@
 #include "Transpositions.hpp"
 
 namespace Brainiac {
-    Transpositions::Transpositions() : _table(TABLE_SIZE) { clear(); }
+    Transpositions::Transpositions(std::size_t megabytes) :
+        _table(nullptr), _size(0), _generation(0), _mapping(nullptr),
+        _mapping_bytes(0) {
+        resize(megabytes);
+    }
+
+    Transpositions::~Transpositions() { release(); }
 
-    Node Transpositions::get(Position &position) const {
-        return _table[position.hash() & TABLE_MASK];
+    void Transpositions::release() {
+#ifdef __linux__
+        if (_mapping) {
+            munmap(_mapping, _mapping_bytes);
+            _mapping = nullptr;
+            _mapping_bytes = 0;
+            _table = nullptr;
+        }
+#endif
+        std::free(_table);
+        _table = nullptr;
+        _size = 0;
     }
 
-    void Transpositions::set(Position &position,
+    Cluster &Transpositions::cluster(Hash hash) const {
+        // Map the low 32 bits onto [0, size) so any size can be indexed
+        return _table[(static_cast<uint32_t>(hash) * _size) >> 32];
+    }
+
+    Entry Transpositions::pack(Hash hash,
+                               NodeType type,
+                               Depth depth,
+                               Value value,
+                               Move move) const {
+        Entry key = hash >> 48;
+        Entry move_bits = std::bit_cast<uint16_t>(move);
+        Entry value_bits = std::bit_cast<uint16_t>(value);
+        Entry depth_bits = std::bit_cast<uint8_t>(depth);
+        Entry generation_bits = _generation << 2;
+        Entry type_bits = type ^ NodeType::Invalid;
+        return (key << 48) | (move_bits << 32) | (value_bits << 16) |
+               (depth_bits << 8) | generation_bits | type_bits;
+    }
+
+    Node Transpositions::unpack(Entry entry, Hash hash) {
+        Node node;
+        node.type = static_cast<NodeType>((entry & 0x3) ^ NodeType::Invalid);
+        if (node.type == NodeType::Invalid || (entry >> 48) != (hash >> 48)) {
+            node.type = NodeType::Invalid;
+            return node;
+        }
+        node.depth = std::bit_cast<Depth>(static_cast<uint8_t>(entry >> 8));
+        node.value = std::bit_cast<Value>(static_cast<uint16_t>(entry >> 16));
+        node.move = std::bit_cast<Move>(static_cast<uint16_t>(entry >> 32));
+        return node;
+    }
+
+    uint8_t Transpositions::age(Entry entry) const {
+        uint8_t generation = (entry & 0xFF) >> 2;
+        return (_generation - generation) & (GENERATION_CYCLE - 1);
+    }
+
+    void Transpositions::allocate(std::size_t megabytes) {
+        megabytes = std::clamp(megabytes, std::size_t(1), MAX_TABLE_MB);
+        std::size_t bytes = megabytes << 20;
+
+        // Align large tables to huge pages to reduce TLB misses
+        std::size_t alignment = alignof(Cluster);
+        if (bytes >= HUGE_PAGE_SIZE) {
+            alignment = HUGE_PAGE_SIZE;
+            bytes = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        }
+
+        release();
+        _table = static_cast<Cluster *>(std::aligned_alloc(alignment, bytes));
+        if (!_table) {
+            throw std::bad_alloc();
+        }
+        _size = bytes / sizeof(Cluster);
+
+#ifdef __linux__
+        if (alignment == HUGE_PAGE_SIZE) {
+            madvise(_table, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    void Transpositions::resize(std::size_t megabytes) {
+        allocate(megabytes);
+        clear();
+    }
+
+    void Transpositions::resize(std::size_t megabytes, ThreadPool &pool) {
+        allocate(megabytes);
+        clear(pool);
+    }
+
+    std::size_t Transpositions::capacity() const {
+        return _size * CLUSTER_SIZE;
+    }
+
+    unsigned Transpositions::hashfull() const {
+        std::size_t clusters = std::min<std::size_t>(
+            HASHFULL_SAMPLES / CLUSTER_SIZE, _size);
+
+        unsigned used = 0;
+        for (std::size_t i = 0; i < clusters; i++) {
+            for (Entry &slot : _table[i].entries) {
+                Entry entry = std::atomic_ref<Entry>(slot).load(
+                    std::memory_order_relaxed);
+                used += entry && !age(entry);
+            }
+        }
+        return used * 1000 / (clusters * CLUSTER_SIZE);
+    }
+
+    Node Transpositions::get(Hash hash, TableStats *stats) const {
+        if (stats) TableStats::increment(stats->probes);
+
+        Cluster &entries = cluster(hash);
+        bool full = true;
+        for (Entry &slot : entries.entries) {
+            Entry entry = std::atomic_ref<Entry>(slot).load(
+                std::memory_order_relaxed);
+            Node node = unpack(entry, hash);
+            if (node.type != NodeType::Invalid) {
+                if (stats) TableStats::increment(stats->hits);
+                return node;
+            }
+            full &= entry != 0;
+        }
+
+        if (stats && full) TableStats::increment(stats->collisions);
+        return {};
+    }
+
+    Node Transpositions::get(Position &position, TableStats *stats) const {
+        return get(position.hash(), stats);
+    }
+
+    void Transpositions::set(Hash hash,
                              NodeType type,
                              Depth depth,
                              Value value,
-                             Move move) {
-        // Overwrite if new entry's depth if higher
-        Hash hash = position.hash();
-        Node &node = _table[hash & TABLE_MASK];
-        if (node.type == NodeType::Invalid ||
-            (node.hash == hash && depth >= node.depth)) {
-            node.type = type;
-            node.depth = depth;
-            node.value = value;
-            node.move = move;
-            node.hash = hash;
+                             Move move,
+                             TableStats *stats) {
+        Cluster &entries = cluster(hash);
+        Entry *victim = &entries.entries[0];
+        int victim_score = std::numeric_limits<int>::max();
+        bool evict = true;
+
+        for (Entry &slot : entries.entries) {
+            Entry entry = std::atomic_ref<Entry>(slot).load(
+                std::memory_order_relaxed);
+
+            // Free slot
+            if (!entry) {
+                victim = &slot;
+                evict = false;
+                break;
+            }
+
+            // Same position, only overwrite with deeper or fresher results
+            Node node = unpack(entry, hash);
+            if (node.type != NodeType::Invalid) {
+                if (depth < node.depth && !age(entry)) return;
+                victim = &slot;
+                evict = false;
+                break;
+            }
+
+            // Weigh depth, age and bound type of the existing entry
+            NodeType entry_type =
+                static_cast<NodeType>((entry & 0x3) ^ NodeType::Invalid);
+            Depth entry_depth =
+                std::bit_cast<Depth>(static_cast<uint8_t>(entry >> 8));
+            int score = entry_depth - 8 * age(entry) +
+                        2 * (entry_type == NodeType::Exact);
+            if (score < victim_score) {
+                victim = &slot;
+                victim_score = score;
+            }
         }
+
+        if (stats && evict) TableStats::increment(stats->overwrites);
+
+        std::atomic_ref<Entry>(*victim).store(
+            pack(hash, type, depth, value, move),
+            std::memory_order_relaxed);
+    }
+
+    void Transpositions::set(Position &position,
+                             NodeType type,
+                             Depth depth,
+                             Value value,
+                             Move move,
+                             TableStats *stats) {
+        set(position.hash(), type, depth, value, move, stats);
+    }
+
+    void Transpositions::next_generation() {
+        _generation = (_generation + 1) & (GENERATION_CYCLE - 1);
     }
 
     void Transpositions::clear() {
-        Node node;
-        node.type = NodeType::Invalid;
-        std::fill(_table.begin(), _table.end(), node);
+        std::memset(static_cast<void *>(_table), 0, _size * sizeof(Cluster));
+    }
+
+    void Transpositions::clear(ThreadPool &pool) {
+        unsigned threads = pool.size();
+        if (!threads) {
+            clear();
+            return;
+        }
+
+        std::size_t chunk = (_size + threads - 1) / threads;
+
+        // Each worker zeroes a contiguous range of clusters
+        for (unsigned i = 0; i < threads; i++) {
+            std::size_t begin = std::min(i * chunk, _size);
+            std::size_t end = std::min(begin + chunk, _size);
+            pool.submit([this, begin, end]() {
+                std::memset(static_cast<void *>(_table + begin),
+                            0,
+                            (end - begin) * sizeof(Cluster));
+            });
+        }
+        pool.wait();
+    }
+
+    bool Transpositions::save(const std::string &path) const {
+        // The table may be a mapping of the file itself, so the new file is
+        // written beside it and renamed over it once complete
+        std::string temp_path = path + ".tmp";
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        TableHeader header{};
+        header.magic = TABLE_FILE_MAGIC;
+        header.version = TABLE_FILE_VERSION;
+        header.seed = ZOBRIST_SEED;
+        header.clusters = _size;
+        header.generation = _generation;
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(_table),
+                   _size * sizeof(Cluster));
+        file.close();
+        if (!file || std::rename(temp_path.c_str(), path.c_str())) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool Transpositions::load(const std::string &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        std::size_t file_bytes = file.tellg();
+        file.seekg(0);
+
+        // Validate the header before touching the current table
+        TableHeader header;
+        if (file_bytes < sizeof(header)) return false;
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        std::size_t table_bytes = header.clusters * sizeof(Cluster);
+        if (!file || header.magic != TABLE_FILE_MAGIC ||
+            header.version != TABLE_FILE_VERSION ||
+            header.seed != ZOBRIST_SEED || header.clusters == 0 ||
+            header.clusters > (MAX_TABLE_MB << 20) / sizeof(Cluster) ||
+            file_bytes != sizeof(header) + table_bytes) {
+            return false;
+        }
+
+#ifdef __linux__
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        void *mapping = mmap(nullptr,
+                             file_bytes,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE,
+                             fd,
+                             0);
+        close(fd);
+        if (mapping == MAP_FAILED) return false;
+
+        release();
+        _mapping = mapping;
+        _mapping_bytes = file_bytes;
+        _table = reinterpret_cast<Cluster *>(
+            static_cast<char *>(mapping) + sizeof(header));
+#else
+        void *table = std::aligned_alloc(alignof(Cluster), table_bytes);
+        if (!table) return false;
+        file.read(static_cast<char *>(table), table_bytes);
+        if (!file) {
+            std::free(table);
+            return false;
+        }
+
+        release();
+        _table = static_cast<Cluster *>(table);
+#endif
+        _size = header.clusters;
+        _generation = header.generation & (GENERATION_CYCLE - 1);
+        return true;
     }
 } // namespace Brainiac
\ No newline at end of file
@@ -1,24 +1,61 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "Evaluation.hpp"
 #include "Move.hpp"
 #include "Numeric.hpp"
 #include "Position.hpp"
+#include "TableStats.hpp"
+#include "ThreadPool.hpp"
 
 namespace Brainiac {
     /**
-     * @brief Size of the transposition table.
+     * @brief Default size of the transposition table in megabytes.
+     *
+     */
+    constexpr std::size_t DEFAULT_TABLE_MB = 16;
+
+    /**
+     * @brief Maximum size of the transposition table in megabytes.
+     *
+     */
+    constexpr std::size_t MAX_TABLE_MB = 1 << 18;
+
+    /**
+     * @brief Tables at least this large are aligned to huge page boundaries.
      *
      */
-    constexpr unsigned TABLE_SIZE = 1 << 24;
+    constexpr std::size_t HUGE_PAGE_SIZE = 1 << 21;
 
     /**
-     * @brief Mask to compute the table index.
+     * @brief Number of entries per cluster.
      *
      */
-    constexpr unsigned TABLE_MASK = TABLE_SIZE - 1;
+    constexpr unsigned CLUSTER_SIZE = 8;
+
+    /**
+     * @brief Number of distinct search generations before the age wraps.
+     *
+     */
+    constexpr uint8_t GENERATION_CYCLE = 64;
 
     /**
      * @brief Types of nodes depending on their value
@@ -35,26 +72,219 @@ namespace Brainiac {
         Depth depth;
         Value value;
         Move move;
-        Hash hash;
+    };
+
+    /**
+     * @brief Number of entries sampled to estimate how full the table is.
+     *
+     */
+    constexpr unsigned HASHFULL_SAMPLES = 1000;
+
+    /**
+     * @brief Magic number identifying a saved transposition table ("BRNCHASH").
+     *
+     */
+    constexpr uint64_t TABLE_FILE_MAGIC = 0x485341484E435242;
+
+    /**
+     * @brief Version of the entry layout written to table files. Bump this
+     * whenever `Entry` or `Cluster` change.
+     *
+     */
+    constexpr uint32_t TABLE_FILE_VERSION = 2;
+
+    /**
+     * @brief Packed transposition entry.
+     *
+     * The whole entry fits in a single 64-bit word so it is always read and
+     * written atomically, and threads sharing the table can never observe a
+     * torn entry. The low bits of the hash select the cluster, the top 16 bits
+     * are stored as the key. A matching key can still be a false hit from
+     * another position, so callers must validate the move before playing it:
+     *
+     * | key (16) | move (16) | value (16) | depth (8) | generation (6) |
+     * | type (2) |
+     *
+     * The type is stored XOR'd with `NodeType::Invalid` so that a zeroed
+     * entry is empty, and clearing the table is a plain memset.
+     *
+     */
+    using Entry = uint64_t;
+
+    /**
+     * @brief Group of entries sharing a single cache line.
+     *
+     */
+    struct alignas(64) Cluster {
+        std::array<Entry, CLUSTER_SIZE> entries;
+    };
+
+    /**
+     * @brief Header of a saved transposition table. The clusters follow it
+     * directly in the file, so its size keeps them cache line aligned.
+     *
+     */
+    struct alignas(64) TableHeader {
+        uint64_t magic;
+        uint32_t version;
+        uint64_t seed;
+        uint64_t clusters;
+        uint8_t generation;
     };
 
     /**
      * @brief Transposition table.
      *
+     * Entries are accessed through `std::atomic_ref`, so the clusters can live
+     * in raw aligned memory, or in a memory mapped table file.
+     *
      */
     class Transpositions {
-        std::vector<Node> _table;
+        Cluster *_table;
+        std::size_t _size;
+        uint8_t _generation;
+
+        void *_mapping;
+        std::size_t _mapping_bytes;
+
+        /**
+         * @brief Release the table memory, whether allocated or mapped.
+         *
+         */
+        void release();
+
+        /**
+         * @brief Allocate the table memory without clearing it.
+         *
+         * @param megabytes
+         */
+        void allocate(std::size_t megabytes);
+
+        /**
+         * @brief Get the cluster of a hash.
+         *
+         * @param hash
+         * @return Cluster&
+         */
+        Cluster &cluster(Hash hash) const;
+
+        /**
+         * @brief Pack a node into an entry.
+         *
+         * @param hash
+         * @param type
+         * @param depth
+         * @param value
+         * @param move
+         * @return Entry
+         */
+        Entry pack(Hash hash,
+                   NodeType type,
+                   Depth depth,
+                   Value value,
+                   Move move) const;
+
+        /**
+         * @brief Unpack an entry into a node. Returns an invalid node if the
+         * entry key does not match the hash.
+         *
+         * @param entry
+         * @param hash
+         * @return Node
+         */
+        static Node unpack(Entry entry, Hash hash);
+
+        /**
+         * @brief Get the number of generations since an entry was written.
+         *
+         * @param entry
+         * @return uint8_t
+         */
+        uint8_t age(Entry entry) const;
 
       public:
-        Transpositions();
+        /**
+         * @brief Construct a table of a given size in megabytes.
+         *
+         * @param megabytes
+         */
+        Transpositions(std::size_t megabytes = DEFAULT_TABLE_MB);
+        ~Transpositions();
+
+        Transpositions(const Transpositions &) = delete;
+        Transpositions &operator=(const Transpositions &) = delete;
+
+        /**
+         * @brief Reallocate the table to a given size in megabytes. This also
+         * clears the table.
+         *
+         * @param megabytes
+         */
+        void resize(std::size_t megabytes);
+
+        /**
+         * @brief Reallocate the table to a given size in megabytes, clearing
+         * it with the workers of a thread pool.
+         *
+         * @param megabytes
+         * @param pool
+         */
+        void resize(std::size_t megabytes, ThreadPool &pool);
+
+        /**
+         * @brief Get the number of entries the table can hold.
+         *
+         * @return std::size_t
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Estimate the per-mille of the table used by the current
+         * generation, sampled from the first entries.
+         *
+         * @return unsigned
+         */
+        unsigned hashfull() const;
+
+        /**
+         * @brief Read an entry from the table.
+         *
+         * @param hash
+         * @param stats Optional counters to update
+         * @return Node
+         */
+        Node get(Hash hash, TableStats *stats = nullptr) const;
 
         /**
          * @brief Read an entry from the table.
          *
          * @param position
+         * @param stats Optional counters to update
          * @return Node
          */
-        Node get(Position &position) const;
+        Node get(Position &position, TableStats *stats = nullptr) const;
+
+        /**
+         * @brief Set an entry to the table.
+         *
+         * An existing entry for the same position is only replaced by a
+         * result of equal or higher depth. Otherwise the least valuable entry
+         * in the cluster is evicted, preferring entries from older searches,
+         * then shallower entries, then non-exact bounds.
+         *
+         * @param hash
+         * @param type
+         * @param depth
+         * @param value
+         * @param move
+         * @param stats Optional counters to update
+         */
+        void set(Hash hash,
+                 NodeType type,
+                 Depth depth,
+                 Value value,
+                 Move move,
+                 TableStats *stats = nullptr);
 
         /**
          * @brief Set an entry to the table.
@@ -64,17 +294,58 @@ namespace Brainiac {
          * @param depth
          * @param value
          * @param move
+         * @param stats Optional counters to update
          */
         void set(Position &position,
                  NodeType type,
                  Depth depth,
                  Value value,
-                 Move move);
+                 Move move,
+                 TableStats *stats = nullptr);
+
+        /**
+         * @brief Start a new search generation. Entries written in previous
+         * generations become preferred replacement victims. This is much
+         * cheaper than clearing, as no memory is touched.
+         *
+         */
+        void next_generation();
 
         /**
          * @brief Clear the table.
          *
          */
         void clear();
+
+        /**
+         * @brief Clear the table, splitting the work across the workers of a
+         * thread pool.
+         *
+         * @param pool
+         */
+        void clear(ThreadPool &pool);
+
+        /**
+         * @brief Write the table to a file. The file is replaced atomically, so
+         * a table loaded from the same path can be saved back to it.
+         *
+         * @param path
+         * @return true if the file was written
+         */
+        bool save(const std::string &path) const;
+
+        /**
+         * @brief Replace the table with the contents of a file written by
+         * save(). On Linux the file is memory mapped copy-on-write, so pages
+         * are only read as they are probed and the file is never modified.
+         *
+         * Files with a different magic, layout version or Zobrist seed, or
+         * whose size does not match their header, are rejected, leaving the
+         * table untouched. Otherwise the table takes the size of the file.
+         *
+         * @param path
+         * @return true if the table was loaded
+         */
+        bool load(const std::string &path);
     };
-} // namespace Brainiac
\ No newline at end of file
+} // namespace Brainiac
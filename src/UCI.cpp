@@ -16,21 +16,28 @@ namespace Brainiac {
             std::cout << stream.str() << std::endl;
         });
 
-        _search.set_pv_callback([](PVInfo &info) {
+        _search.set_pv_callback([&](PVInfo &info) {
             unsigned time_ms = info.time.count() * 1000;
-            unsigned nps = info.nodes / info.time.count();
+            uint64_t nps = info.nodes / info.time.count();
 
             std::ostringstream stream;
             stream << "info depth " << static_cast<unsigned>(info.depth);
             stream << " time " << time_ms;
             stream << " nodes " << info.nodes;
             stream << " nps " << nps;
+            stream << " hashfull " << info.hashfull;
             stream << " score cp " << info.value;
             stream << " pv";
             for (unsigned i = 0; i < info.pv_length; i++) {
                 stream << " " << info.pv[i].standard_notation();
             }
             std::cout << stream.str() << std::endl;
+
+            if (_debug) {
+                print_table_stats("tt", info.table);
+                print_table_stats("pawn", info.pawn_table);
+                print_table_stats("eval", info.eval_cache);
+            }
         });
 
         _search.set_bestmove_callback([](Move move) {
@@ -39,11 +46,69 @@ namespace Brainiac {
             std::cout << stream.str() << std::endl;
         });
 
+        // Assign option handlers
+
+        _option_map["Threads"] = {
+            "type spin default 1 min 1 max " + std::to_string(MAX_THREADS),
+            spin_handler("Threads", 1, MAX_THREADS, [&](std::size_t count) {
+                return _search.set_threads(count);
+            }),
+        };
+
+        _option_map["Hash"] = {
+            "type spin default " + std::to_string(DEFAULT_TABLE_MB) +
+                " min 1 max " + std::to_string(MAX_TABLE_MB),
+            spin_handler("Hash", 1, MAX_TABLE_MB, [&](std::size_t megabytes) {
+                return _search.set_hash(megabytes);
+            }),
+        };
+
+        _option_map["EvalCache"] = {
+            "type spin default " + std::to_string(DEFAULT_EVAL_CACHE_MB) +
+                " min 1 max " + std::to_string(MAX_EVAL_CACHE_MB),
+            spin_handler("EvalCache",
+                         1,
+                         MAX_EVAL_CACHE_MB,
+                         [&](std::size_t megabytes) {
+                             return _search.set_eval_cache(megabytes);
+                         }),
+        };
+
+        _option_map["PEXT"] = {
+            SLIDER_INDEXING == SliderIndexing::IndexPext
+                ? "type check default true"
+                : "type check default false",
+            [&](const std::string &value) {
+                SliderIndexing indexing = value == "true"
+                                              ? SliderIndexing::IndexPext
+                                              : SliderIndexing::IndexMagic;
+                if (!_search.set_slider_indexing(indexing)) {
+                    std::cout << "Could not change PEXT during a search or "
+                                 "on this CPU"
+                              << std::endl;
+                }
+            },
+        };
+
+        _option_map["Clear Hash"] = {
+            "type button",
+            [&](const std::string &value) {
+                if (!_search.clear_hash()) {
+                    std::cout << "Could not clear hash during a search"
+                              << std::endl;
+                }
+            },
+        };
+
         // Assign command handlers
 
         _command_map["uci"] = [&](Tokens &args) {
             std::cout << "id name Brainiac " << get_engine_version() << "\n";
             std::cout << "id author Keith Leonardo\n";
+            for (auto &entry : _option_map) {
+                std::cout << "option name " << entry.first << " "
+                          << entry.second.definition << "\n";
+            }
             std::cout << "uciok" << std::endl;
         };
 
@@ -71,7 +136,7 @@ namespace Brainiac {
 
             unsigned moves_offset = 1;
             if (args[0] == "startpos") {
-                _position = Position(DEFAULT_BOARD_FEN, _hasher);
+                _position = Position(DEFAULT_BOARD_FEN);
             } else if (args[0] == "fen" && args.size() >= 7) {
                 std::string fen = "";
                 for (unsigned i = 0; i < 6; i++) {
@@ -80,7 +145,7 @@ namespace Brainiac {
                         fen += " ";
                     }
                 }
-                _position = Position(fen, _hasher);
+                _position = Position(fen);
                 moves_offset = 7;
             }
 
@@ -93,7 +158,7 @@ namespace Brainiac {
                                   << std::endl;
                         break;
                     }
-                    _position.make(move);
+                    _position.play(move);
                 }
             }
         };
@@ -130,15 +195,39 @@ namespace Brainiac {
                 if (_search_thread.joinable()) {
                     _search_thread.join();
                 }
-                _search_thread = std::thread(&Search::go,
-                                             &_search,
-                                             std::ref(_position),
-                                             limits);
+
+                // Mark the search as running before the thread starts, so
+                // options sent right after go are rejected
+                if (_search.start()) {
+                    _search_thread = std::thread(&Search::run,
+                                                 &_search,
+                                                 std::ref(_position),
+                                                 limits);
+                }
             }
         };
 
         _command_map["setoption"] = [&](Tokens &args) {
-            // TODO: Add customizable options to Search
+            // setoption name <id> [value <x>], where both may contain spaces
+            std::string name = "";
+            std::string value = "";
+            std::string *field = nullptr;
+            for (std::string &token : args) {
+                if (token == "name") {
+                    field = &name;
+                } else if (token == "value") {
+                    field = &value;
+                } else if (field) {
+                    if (field->length()) *field += " ";
+                    *field += token;
+                }
+            }
+
+            if (!_option_map.contains(name)) {
+                std::cout << "No such option: " << name << std::endl;
+                return;
+            }
+            _option_map.at(name).handler(value);
         };
 
         _command_map["stop"] = [&](Tokens &args) { _search.stop(); };
@@ -173,6 +262,84 @@ namespace Brainiac {
             std::cout << "Placement (White PoV): " << placement << "\n";
             std::cout << "Evaluation: " << eval << std::endl;
         };
+
+        _command_map["hashstats"] = [&](Tokens &args) {
+            std::cout << "Entries: " << _search.hash_capacity() << "\n";
+            std::cout << "Hashfull: " << _search.hashfull() << "\n";
+            print_table_stats("tt", _search.table_stats());
+            print_table_stats("pawn", _search.pawn_table_stats());
+            print_table_stats("eval", _search.eval_cache_stats());
+        };
+
+        _command_map["savehash"] = [&](Tokens &args) {
+            if (args.empty()) {
+                std::cout << "Usage: savehash <file>" << std::endl;
+            } else if (_search.save_hash(args[0])) {
+                std::cout << "Saved hash to " << args[0] << std::endl;
+            } else {
+                std::cout << "Could not save hash to " << args[0] << std::endl;
+            }
+        };
+
+        _command_map["loadhash"] = [&](Tokens &args) {
+            if (args.empty()) {
+                std::cout << "Usage: loadhash <file>" << std::endl;
+            } else if (_search.load_hash(args[0])) {
+                // The table takes the size of the file, not the Hash option
+                std::size_t megabytes =
+                    (_search.hash_capacity() * sizeof(Entry)) >> 20;
+                std::cout << "info string Hash is now " << megabytes
+                          << " MB\n";
+                std::cout << "Loaded hash from " << args[0] << std::endl;
+            } else {
+                std::cout << "Could not load hash from " << args[0]
+                          << std::endl;
+            }
+        };
+    }
+
+    std::optional<std::size_t> UCI::parse_spin(const std::string &value,
+                                               std::size_t min,
+                                               std::size_t max) {
+        std::size_t number;
+        const char *first = value.data();
+        const char *last = first + value.size();
+        auto [ptr, error] = std::from_chars(first, last, number);
+        if (error == std::errc::result_out_of_range) return max;
+        if (error != std::errc() || ptr != last) return {};
+        return std::clamp(number, min, max);
+    }
+
+    UCI::OptionHandler
+    UCI::spin_handler(const std::string &name,
+                      std::size_t min,
+                      std::size_t max,
+                      std::function<bool(std::size_t)> setter) {
+        return [=](const std::string &value) {
+            std::optional<std::size_t> number = parse_spin(value, min, max);
+            if (!number) {
+                std::cout << "Invalid value for " << name << ": " << value
+                          << std::endl;
+            } else if (!setter(*number)) {
+                std::cout << "Could not change " << name << " during a search"
+                          << std::endl;
+            }
+        };
+    }
+
+    void UCI::print_table_stats(const std::string &name,
+                                const TableStats &stats) {
+        std::ostringstream stream;
+        stream << "info string " << name;
+        stream << " probes " << stats.probes;
+        stream << " hits " << stats.hits;
+        stream << " cutoffs " << stats.cutoffs;
+        stream << " collisions " << stats.collisions;
+        stream << " overwrites " << stats.overwrites;
+        if (stats.probes) {
+            stream << " hitrate " << stats.hits * 1000 / stats.probes;
+        }
+        std::cout << stream.str() << std::endl;
     }
 
     void UCI::perft_handler(unsigned depth) {
@@ -184,8 +351,10 @@ namespace Brainiac {
         Seconds stop = time();
         Seconds duration = stop - start;
 
+        uint64_t nps = nodes / std::max(duration.count(), 1e-6f);
+
         std::cout << "Perft(" << depth << ") = " << nodes << " ("
-                  << duration.count() << "s)" << std::endl;
+                  << duration.count() << "s, " << nps << " nps)" << std::endl;
     }
 
     void UCI::run() {
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
@@ -17,12 +20,33 @@ namespace Brainiac {
         using Tokens = std::vector<std::string>;
         using CommandHandler = std::function<void(Tokens &)>;
         using CommandMap = std::unordered_map<std::string, CommandHandler>;
+        using OptionHandler = std::function<void(const std::string &)>;
+
+        /**
+         * @brief Configurable engine option.
+         *
+         */
+        struct Option {
+            /**
+             * @brief Option type definition sent in response to `uci`, e.g.,
+             * "type spin default 1 min 1 max 256".
+             *
+             */
+            std::string definition;
+
+            /**
+             * @brief Handler invoked with the option value.
+             *
+             */
+            OptionHandler handler;
+        };
+        using OptionMap = std::unordered_map<std::string, Option>;
 
-        Hasher _hasher;
         Search _search;
         Position _position;
 
         CommandMap _command_map;
+        OptionMap _option_map;
 
         bool _debug;
         bool _running;
@@ -35,6 +59,41 @@ namespace Brainiac {
          */
         void perft_handler(unsigned depth);
 
+        /**
+         * @brief Parse a spin option value, clamped to its advertised range.
+         *
+         * @param value
+         * @param min
+         * @param max
+         * @return std::optional<std::size_t> Empty if value is not a number.
+         */
+        static std::optional<std::size_t>
+        parse_spin(const std::string &value, std::size_t min, std::size_t max);
+
+        /**
+         * @brief Create a handler for a spin option. Invalid values and
+         * changes rejected by the setter are reported and ignored.
+         *
+         * @param name
+         * @param min
+         * @param max
+         * @param setter Applies the value, returns false if it was rejected.
+         * @return OptionHandler
+         */
+        OptionHandler spin_handler(const std::string &name,
+                                   std::size_t min,
+                                   std::size_t max,
+                                   std::function<bool(std::size_t)> setter);
+
+        /**
+         * @brief Print hash table counters as an info string.
+         *
+         * @param name
+         * @param stats
+         */
+        void print_table_stats(const std::string &name,
+                               const TableStats &stats);
+
       public:
         UCI();
 
@@ -0,0 +1,93 @@
+#include <iostream>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static char *test_eval_cache_set() {
+    EvalCache ecache(1);
+    std::size_t entries_per_mb = (1 << 20) / sizeof(uint64_t);
+    mu_assert("Capacity", ecache.capacity() == entries_per_mb);
+
+    Hash hash = 0x123456789ABCDEF0;
+    Value value;
+    mu_assert("Initial Miss", !ecache.get(hash, value));
+
+    ecache.set(hash, -321);
+    mu_assert("Hit", ecache.get(hash, value));
+    mu_assert("Negative Value", value == -321);
+
+    // Same slot, different position
+    Hash other = hash ^ (1ULL << 63);
+    mu_assert("Key Mismatch", !ecache.get(other, value));
+    ecache.set(other, 5);
+    mu_assert("Replaced", !ecache.get(hash, value));
+
+    ecache.clear();
+    mu_assert("Cleared", !ecache.get(other, value));
+
+    ecache.set(hash, 7);
+    ecache.resize(2);
+    mu_assert("Resized Capacity", ecache.capacity() == 2 * entries_per_mb);
+    mu_assert("Resize Clears", !ecache.get(hash, value));
+    return 0;
+}
+
+static char *test_eval_cache_stats() {
+    EvalCache ecache(1);
+    TableStats stats;
+
+    Value value;
+    ecache.get(42, value, &stats);
+    ecache.set(42, 10);
+    ecache.get(42, value, &stats);
+    mu_assert("Probes", stats.probes == 2);
+    mu_assert("Hits", stats.hits == 1);
+    return 0;
+}
+
+static char *test_eval_cache_evaluate() {
+    EvalCache ecache(1);
+    PawnTable ptable;
+    TableStats stats;
+
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        Value expected = evaluate(pos);
+        Value miss = evaluate(pos, ptable, ecache, &stats);
+        Value hit = evaluate(pos, ptable, ecache, &stats);
+        mu_assert("Cache Miss", miss == expected);
+        mu_assert("Cache Hit", hit == expected);
+    }
+    mu_assert("Evaluate Hits", stats.hits == 3);
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_eval_cache_set);
+    mu_run_test(test_eval_cache_stats);
+    mu_run_test(test_eval_cache_evaluate);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
@@ -171,10 +171,105 @@ static char *test_evaluate() {
     return 0;
 }
 
+static char *test_compute_pawn_structure() {
+    // Lone pawn is passed and isolated
+    Position lone("4k3/8/8/8/8/8/4P3/4K3 w - - 0 1");
+    PawnEntry entry = compute_pawn_structure(lone.board());
+    mu_assert("Lone Value",
+              entry.value[Color::White] ==
+                  PASSED_PAWN_BONUS[1] - ISOLATED_PAWN_PENALTY);
+    mu_assert("Lone Opponent Value", entry.value[Color::Black] == 0);
+    mu_assert("Lone Passed", entry.passed[Color::White] == (1ULL << E2));
+    mu_assert("Lone Attacks",
+              entry.attacks[Color::White] == ((1ULL << D3) | (1ULL << F3)));
+
+    // Doubled pawns
+    Position doubled("4k3/8/8/8/8/4P3/4P3/4K3 w - - 0 1");
+    entry = compute_pawn_structure(doubled.board());
+    mu_assert("Doubled Value",
+              entry.value[Color::White] ==
+                  PASSED_PAWN_BONUS[1] + PASSED_PAWN_BONUS[2] -
+                      2 * ISOLATED_PAWN_PENALTY - DOUBLED_PAWN_PENALTY);
+
+    // Pawns stopped by enemy pawns on the same or adjacent files
+    Position blocked("4k3/8/4p3/8/3P4/8/8/4K3 b - - 0 1");
+    entry = compute_pawn_structure(blocked.board());
+    mu_assert("Blocked Passed",
+              !entry.passed[Color::White] && !entry.passed[Color::Black]);
+    mu_assert("Blocked Value",
+              entry.value[Color::White] == -ISOLATED_PAWN_PENALTY &&
+                  entry.value[Color::Black] == -ISOLATED_PAWN_PENALTY);
+
+    // Black passed pawns count ranks from their side
+    Position black("4k3/8/8/8/8/4p3/8/4K3 w - - 0 1");
+    entry = compute_pawn_structure(black.board());
+    mu_assert("Black Passed", entry.passed[Color::Black] == (1ULL << E3));
+    mu_assert("Black Attack Spans",
+              entry.attack_spans[Color::Black] ==
+                  ((1ULL << D2) | (1ULL << F2) | (1ULL << D1) | (1ULL << F1)));
+    mu_assert("Black Value",
+              entry.value[Color::Black] ==
+                  PASSED_PAWN_BONUS[5] - ISOLATED_PAWN_PENALTY);
+    return 0;
+}
+
+static char *test_evaluate_pawn_table() {
+    PawnTable ptable;
+    std::vector<std::string> fens = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "4k3/8/8/8/8/8/8/R3K3 w Q - 0 1",
+    };
+    for (const std::string &fen : fens) {
+        Position pos(fen);
+        test_label = "Pawn table evaluation (" + fen + ")";
+        mu_assert(test_label.c_str(), evaluate(pos, ptable) == evaluate(pos));
+        mu_assert(test_label.c_str(), evaluate(pos, ptable) == evaluate(pos));
+    }
+    TableStats stats = ptable.stats();
+    mu_assert("Pawn table probes", stats.probes == 2 * fens.size());
+    mu_assert("Pawn table hits", stats.hits >= fens.size());
+    return 0;
+}
+
+static bool scores_match(Position &pos, unsigned depth) {
+    const Board &board = pos.board();
+    bool match = board.material() == compute_material(board) &&
+                 board.placement() == compute_placement(board);
+    if (!depth) return match;
+
+    MoveList moves = pos.moves();
+    for (Move move : moves) {
+        pos.make(move);
+        match &= scores_match(pos, depth - 1);
+        pos.undo();
+    }
+    return match && board.material() == compute_material(board) &&
+           board.placement() == compute_placement(board);
+}
+
+static char *test_incremental_scores() {
+    // Castling, en passant, promotions and captures
+    std::vector<std::string> fens = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+    };
+    for (const std::string &fen : fens) {
+        Position pos(fen);
+        test_label = "Incremental scores (" + fen + ")";
+        mu_assert(test_label.c_str(), scores_match(pos, 3));
+    }
+    return 0;
+}
+
 static char *all_tests() {
     mu_run_test(test_compute_material);
     mu_run_test(test_compute_placement);
     mu_run_test(test_evaluate);
+    mu_run_test(test_compute_pawn_structure);
+    mu_run_test(test_evaluate_pawn_table);
+    mu_run_test(test_incremental_scores);
     return 0;
 }
 
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <set>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static char *test_hasher_unique() {
+    std::set<Hash> bitstrings(BITSTRINGS.begin(), BITSTRINGS.end());
+    mu_assert("Unique Bitstrings", bitstrings.size() == BITSTRING_COUNT);
+    mu_assert("Non-Zero Bitstrings", !bitstrings.contains(0));
+    return 0;
+}
+
+static char *test_hasher_low_bits() {
+    // Every low bit should be set in roughly half of the bitstrings
+    for (unsigned bit = 0; bit < 16; bit++) {
+        unsigned count = 0;
+        for (Hash bitstring : BITSTRINGS) {
+            count += (bitstring >> bit) & 1;
+        }
+        mu_assert("Low Bit Balance",
+                  count > BITSTRING_COUNT * 2 / 5 &&
+                      count < BITSTRING_COUNT * 3 / 5);
+    }
+    return 0;
+}
+
+static char *test_hasher_compile_time() {
+    static_assert(bitstring(Square::A1, Piece::WhiteKing) == BITSTRINGS[0]);
+    static_assert(generate_bitstrings(ZOBRIST_SEED) == BITSTRINGS);
+    static_assert(generate_bitstrings(ZOBRIST_SEED + 1) != BITSTRINGS);
+    return 0;
+}
+
+static char *test_hasher_position() {
+    Position position;
+    Board board;
+    State state(DEFAULT_BOARD_FEN, board);
+    mu_assert("Position Hash", position.hash() == state.hash);
+    mu_assert("Computed Hash",
+              position.hash() == compute_hash(position.board(),
+                                              state.castling,
+                                              Color::White,
+                                              Square::Null));
+
+    Position copy = position;
+    mu_assert("Copied Hash", copy.hash() == position.hash());
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_hasher_unique);
+    mu_run_test(test_hasher_low_bits);
+    mu_run_test(test_hasher_compile_time);
+    mu_run_test(test_hasher_position);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static char *test_killers() {
+    Killers killers;
+    Move a(Square::E2, Square::E3, MoveType::Quiet);
+    Move b(Square::D2, Square::D3, MoveType::Quiet);
+    Move c(Square::G1, Square::F3, MoveType::Quiet);
+
+    mu_assert("Empty", killers.get(3, 0) == Move());
+
+    killers.set(3, a);
+    killers.set(3, b);
+    mu_assert("Newest first", killers.get(3, 0) == b);
+    mu_assert("Oldest second", killers.get(3, 1) == a);
+
+    // Repeated cutoffs do not duplicate the killer
+    killers.set(3, b);
+    mu_assert("No duplicate", killers.get(3, 1) == a);
+
+    killers.set(3, c);
+    mu_assert("Evict oldest", killers.get(3, 0) == c);
+    mu_assert("Shift", killers.get(3, 1) == b);
+    mu_assert("Other ply", killers.get(4, 0) == Move());
+
+    killers.clear();
+    mu_assert("Clear", killers.get(3, 0) == Move());
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_killers);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+std::vector<std::string> POSITIONS = {
+    DEFAULT_BOARD_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1",
+    "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+    "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1",
+    "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1",
+    "8/P1k5/K7/8/8/8/8/8 w - - 0 1",
+};
+
+/**
+ * @brief Test if a move appears exactly once in a list.
+ *
+ * @param moves
+ * @param move
+ * @return true
+ * @return false
+ */
+static bool contains_once(const MoveList &moves, Move move) {
+    return std::count(moves.begin(), moves.end(), move) == 1;
+}
+
+/**
+ * @brief Compare every generation mode against the full move list, walking
+ * the game tree up to the given depth.
+ *
+ * @param position
+ * @param depth
+ * @return true
+ * @return false
+ */
+static bool modes_match(Position &position, Depth depth) {
+    MoveList all = position.moves();
+    MoveList noisy, quiet, evasions, quiet_checks;
+    position.moves(GenType::GenNoisy, noisy);
+    position.moves(GenType::GenQuiet, quiet);
+    position.moves(GenType::GenEvasions, evasions);
+    position.moves(GenType::GenQuietChecks, quiet_checks);
+
+    // Noisy and quiet moves partition the full list
+    if (noisy.size() + quiet.size() != all.size()) return false;
+    for (Move move : noisy) {
+        if (!is_noisy(move) || !contains_once(all, move)) return false;
+    }
+    for (Move move : quiet) {
+        if (is_noisy(move) || !contains_once(all, move)) return false;
+    }
+
+    // Evasions are the full list only while in check
+    unsigned evasion_count = position.is_check() ? all.size() : 0;
+    if (evasions.size() != evasion_count) return false;
+    for (Move move : evasions) {
+        if (!contains_once(all, move)) return false;
+    }
+
+    // Quiet checks are exactly the quiet moves that give check
+    unsigned checks = 0;
+    for (unsigned i = 0; i < quiet.size(); i++) {
+        Move move = quiet[i];
+        position.make(move);
+        bool gives_check = position.is_check();
+        position.undo();
+        if (gives_check != contains_once(quiet_checks, move)) return false;
+        checks += gives_check;
+    }
+    if (quiet_checks.size() != checks) return false;
+
+    if (depth == 0) return true;
+    for (unsigned i = 0; i < all.size(); i++) {
+        position.make(all[i]);
+        bool match = modes_match(position, depth - 1);
+        position.undo();
+        if (!match) return false;
+    }
+    return true;
+}
+
+static char *test_generation_modes() {
+    for (const std::string &fen : POSITIONS) {
+        Position position(fen);
+        mu_assert("Generation modes match the full move list",
+                  modes_match(position, 2));
+    }
+    return 0;
+}
+
+static char *test_evasions() {
+    Position checked("4k3/8/8/8/8/8/4q3/R3K3 w Q - 0 1");
+    MoveList evasions;
+    checked.moves(GenType::GenEvasions, evasions);
+    mu_assert("Evasions in check", evasions.size() == checked.moves().size());
+
+    Position unchecked(DEFAULT_BOARD_FEN);
+    evasions.clear();
+    unchecked.moves(GenType::GenEvasions, evasions);
+    mu_assert("No evasions out of check", evasions.size() == 0);
+    return 0;
+}
+
+static char *test_slider_tables() {
+    // Re-initializing from several threads leaves the tables intact
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 4; i++) {
+        threads.emplace_back(init);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (unsigned i = 0; i < 64; i++) {
+        Square sq = static_cast<Square>(i);
+        Bitboard rook = (SQUARE_RANKS[i] | SQUARE_FILES[i]) & ~SQUARES[i];
+        Bitboard bishop =
+            (SQUARE_DIAGONALS[i] | SQUARE_ANTI_DIAGONALS[i]) & ~SQUARES[i];
+        mu_assert("Empty board rook attacks", rook_attacks(sq, 0, 0) == rook);
+        mu_assert("Empty board bishop attacks",
+                  bishop_attacks(sq, 0, 0) == bishop);
+    }
+
+    // Blockers are included in the attacks and stop the ray
+    Bitboard blockers = SQUARES[Square::D6] | SQUARES[Square::F4];
+    Bitboard expected = SQUARES[Square::D5] | SQUARES[Square::D6] |
+                        SQUARES[Square::E4] | SQUARES[Square::F4] |
+                        SQUARES[Square::C4] | SQUARES[Square::B4] |
+                        SQUARES[Square::A4] | SQUARES[Square::D3] |
+                        SQUARES[Square::D2] | SQUARES[Square::D1];
+    mu_assert("Blocked rook attacks",
+              rook_attacks(Square::D4, 0, blockers) == expected);
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_generation_modes);
+    mu_run_test(test_evasions);
+    mu_run_test(test_slider_tables);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static std::string KIWIPETE =
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+static char *test_picker_stages() {
+    Position position(KIWIPETE);
+    History history;
+    Killers killers;
+
+    Move hash_move = position.find_move("e2a6");
+    Move killer = position.find_move("a2a3");
+    Move illegal(Square::A1, Square::A8, MoveType::Quiet);
+    killers.set(2, illegal);
+    killers.set(2, killer);
+
+    MovePicker picker(position, history, killers, 2, hash_move, false);
+    mu_assert("Hash stage", picker.stage() == PickerStage::PickHash);
+
+    std::vector<Move> picked;
+    std::vector<PickerStage> stages;
+    std::vector<MoveValue> values;
+    Move move;
+    while (picker.next(move)) {
+        picked.push_back(move);
+        stages.push_back(picker.stage());
+        values.push_back(picker.value());
+    }
+    mu_assert("Done stage", picker.stage() == PickerStage::PickDone);
+
+    // Every legal move is yielded exactly once
+    const MoveList &moves = position.moves();
+    mu_assert("Move count", picked.size() == moves.size());
+    for (Move legal : moves) {
+        unsigned count = std::count(picked.begin(), picked.end(), legal);
+        mu_assert("Yielded once", count == 1);
+    }
+
+    // Stages come in order, starting with the hash move then the killer
+    mu_assert("Hash first", picked[0] == hash_move);
+    mu_assert("Stages ordered", std::is_sorted(stages.begin(), stages.end()));
+    auto killer_it = std::find(picked.begin(), picked.end(), killer);
+    unsigned killer_index = killer_it - picked.begin();
+    mu_assert("Killer stage", stages[killer_index] == PickKillers);
+
+    // Moves within a stage are sorted by value
+    for (unsigned i = 1; i < picked.size(); i++) {
+        if (stages[i] == stages[i - 1]) {
+            mu_assert("Values sorted", values[i] <= values[i - 1]);
+        }
+        mu_assert("Captures first",
+                  stages[i] != PickCaptures || is_noisy(picked[i]));
+    }
+    return 0;
+}
+
+static char *test_picker_qsearch() {
+    Position position(KIWIPETE);
+    History history;
+    Killers killers;
+
+    // Quiet hash moves are not searched by quiescence
+    Move quiet = position.find_move("a2a3");
+    MovePicker picker(position, history, killers, 0, quiet, true);
+
+    unsigned count = 0;
+    Move move;
+    while (picker.next(move)) {
+        mu_assert("Only noisy moves", is_noisy(move));
+        count++;
+    }
+
+    unsigned noisy = 0;
+    for (Move legal : position.moves()) {
+        noisy += is_noisy(legal);
+    }
+    mu_assert("All noisy moves", count == noisy);
+    return 0;
+}
+
+static char *test_picker_invalid_hash() {
+    Position position;
+    History history;
+    Killers killers;
+
+    // A hash move from a colliding position is never played
+    Move illegal(Square::E7, Square::E5, MoveType::PawnDouble);
+    MovePicker picker(position, history, killers, 0, illegal, false);
+
+    unsigned count = 0;
+    Move move;
+    while (picker.next(move)) {
+        mu_assert("Illegal hash move", !(move == illegal));
+        count++;
+    }
+    mu_assert("Move count", count == position.moves().size());
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_picker_stages);
+    mu_run_test(test_picker_qsearch);
+    mu_run_test(test_picker_invalid_hash);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
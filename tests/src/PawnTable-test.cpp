@@ -0,0 +1,98 @@
+#include <iostream>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static char *test_pawn_table_probe() {
+    PawnTable ptable;
+
+    bool hit;
+    PawnEntry &entry = ptable.probe(1, hit);
+    mu_assert("Initial Miss", !hit);
+    entry.key = 1;
+    entry.passed[Color::White] = 42;
+
+    PawnEntry &cached = ptable.probe(1, hit);
+    mu_assert("Hit", hit);
+    mu_assert("Hit Value", cached.passed[Color::White] == 42);
+
+    // Same slot, different structure
+    ptable.probe(1 + PAWN_TABLE_SIZE, hit);
+    mu_assert("Collision Miss", !hit);
+
+    TableStats stats = ptable.stats();
+    mu_assert("Probes", stats.probes == 3);
+    mu_assert("Hits", stats.hits == 1);
+    mu_assert("Overwrites", stats.overwrites == 1);
+
+    ptable.clear();
+    ptable.probe(1, hit);
+    mu_assert("Cleared", !hit);
+
+    ptable.reset_stats();
+    mu_assert("Reset Stats", ptable.stats().probes == 0);
+    return 0;
+}
+
+static char *test_pawn_table_no_pawns() {
+    PawnTable ptable;
+    Position pos("4k3/8/8/8/8/8/8/4K3 w - - 0 1");
+
+    bool hit;
+    PawnEntry &entry = ptable.probe(pos.pawn_hash(), hit);
+    PawnEntry computed = compute_pawn_structure(pos.board());
+    mu_assert("Empty Structure Hit", hit);
+    mu_assert("Empty Structure Attacks", entry.attacks == computed.attacks);
+    return 0;
+}
+
+static void evaluate_leaves(Position &pos, PawnTable &ptable, unsigned depth) {
+    if (!depth) {
+        evaluate(pos, ptable);
+        return;
+    }
+    for (const Move &move : pos.moves()) {
+        pos.make(move);
+        evaluate_leaves(pos, ptable, depth - 1);
+        pos.undo();
+    }
+}
+
+static char *test_pawn_table_hit_rate() {
+    PawnTable ptable;
+    Position pos(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    evaluate_leaves(pos, ptable, 3);
+
+    TableStats stats = ptable.stats();
+    double hit_rate = static_cast<double>(stats.hits) / stats.probes;
+    std::cout << "Hit rate " << hit_rate << " (" << stats.probes
+              << " probes)\n";
+    mu_assert("Pawn Hit Rate", hit_rate > 0.9);
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_pawn_table_probe);
+    mu_run_test(test_pawn_table_no_pawns);
+    mu_run_test(test_pawn_table_hit_rate);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <array>
+#include <chrono>
 #include <iostream>
 
 #include "../../src/Engine.hpp"
@@ -74,14 +75,15 @@ std::vector<PerftTestCase> POSITIONS = {
 };
 
 static char *test_perft_hash() {
-    Hasher hasher;
     for (PerftTestCase &test : POSITIONS) {
-        Position pos(test.fen, hasher);
+        Position pos(test.fen);
         std::cout << "perft(`" << test.fen << "`, " << test.depth << ") ";
         bool hash_match = true;
         auto cb = [&](Move move, uint64_t children) {
-            Position copy(pos.fen(), hasher);
+            Position copy(pos.fen());
             hash_match &= (pos.hash() == copy.hash());
+            hash_match &= (pos.pawn_hash() == copy.pawn_hash());
+            hash_match &= (pos.material_hash() == copy.material_hash());
         };
         uint64_t nodes = perft(pos, test.depth, test.depth, cb);
         std::cout << nodes << " == " << test.result << "?\n";
@@ -91,8 +93,53 @@ static char *test_perft_hash() {
     return 0;
 }
 
+static char *test_perft_indexing() {
+    std::vector<PerftTestCase> cases = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+         5,
+         4865609},
+        {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+         4,
+         4085603},
+    };
+    std::vector<SliderIndexing> methods = {SliderIndexing::IndexMagic};
+    if (cpu_has_pext()) methods.push_back(SliderIndexing::IndexPext);
+
+    // Both slider lookups must visit the same nodes, compare their speed
+    std::vector<uint64_t> magic_nodes;
+    SliderIndexing default_method = SLIDER_INDEXING;
+    for (SliderIndexing method : methods) {
+        mu_assert("Indexing supported", set_slider_indexing(method));
+        for (unsigned i = 0; i < cases.size(); i++) {
+            PerftTestCase &test = cases[i];
+            Position pos(test.fen);
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = perft(pos, test.depth, test.depth);
+            auto end = std::chrono::steady_clock::now();
+            std::chrono::duration<double> seconds = end - start;
+
+            unsigned depth = test.depth;
+            std::cout << (method == IndexPext ? "PEXT" : "Magic") << " perft(`"
+                      << test.fen << "`, " << depth << ") "
+                      << static_cast<uint64_t>(nodes / seconds.count())
+                      << " nps\n";
+            mu_assert("Indexing perft failed", nodes == test.result);
+
+            if (method == IndexMagic) {
+                magic_nodes.push_back(nodes);
+            } else {
+                mu_assert("Indexing node counts differ",
+                          nodes == magic_nodes[i]);
+            }
+        }
+    }
+    set_slider_indexing(default_method);
+    return 0;
+}
+
 static char *all_tests() {
     mu_run_test(test_perft_hash);
+    mu_run_test(test_perft_indexing);
     return 0;
 }
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -41,8 +42,325 @@ static char *test_find_move() {
     return 0;
 }
 
+static bool keys_match(Position &pos, unsigned depth) {
+    Position fresh(pos.fen());
+    bool match = pos.hash() == fresh.hash() &&
+                 pos.pawn_hash() == fresh.pawn_hash() &&
+                 pos.material_hash() == fresh.material_hash();
+    if (!depth) return match;
+
+    for (const Move &move : pos.moves()) {
+        pos.make(move);
+        match &= keys_match(pos, depth - 1);
+        pos.undo();
+    }
+    return match;
+}
+
+static char *test_incremental_keys() {
+    // Castling, en passant, promotions and captures
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        mu_assert("Incremental Keys", keys_match(pos, 3));
+    }
+    return 0;
+}
+
+static char *test_material_key() {
+    // Same material on different squares
+    Position a("4k3/8/8/3p4/8/8/4P3/4K2R w K - 0 1");
+    Position b("4k3/p7/8/8/8/8/P7/R3K3 b Q - 0 1");
+    mu_assert("Material Key Equal", a.material_hash() == b.material_hash());
+    mu_assert("Pawn Key Differs", a.pawn_hash() != b.pawn_hash());
+
+    // Trading pieces changes the material key
+    Position c("4k3/8/8/3p4/8/8/4P3/4K3 w - - 0 1");
+    mu_assert("Material Key Differs", a.material_hash() != c.material_hash());
+    mu_assert("Pawn Key Equal", a.pawn_hash() == c.pawn_hash());
+    return 0;
+}
+
+static bool board_restored(Position &pos, unsigned depth) {
+    std::string fen = pos.fen();
+    if (!depth) return true;
+
+    bool match = true;
+    for (const Move &move : pos.moves()) {
+        pos.make(move);
+        std::string child = pos.fen();
+        match &= board_restored(pos, depth - 1);
+        pos.undo();
+        match &= pos.fen() == fen;
+
+        // Redo replays the move on the board
+        pos.redo();
+        match &= pos.fen() == child;
+        pos.undo();
+    }
+    return match;
+}
+
+static char *test_undo_redo() {
+    // Castling, en passant, promotions and captures
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        mu_assert("Undo Restores Board", board_restored(pos, 3));
+        mu_assert("Undo Restores Fen", pos.fen() == fen);
+    }
+
+    Position pos;
+    pos.make(pos.find_move("e2e4"));
+    pos.skip();
+    pos.undo();
+    pos.undo();
+    mu_assert("Undo Skip", pos.fen() == DEFAULT_BOARD_FEN);
+    mu_assert("Undo Start", pos.is_start() && !pos.is_end());
+    pos.redo();
+    pos.redo();
+    mu_assert("Redo End", pos.is_end());
+    mu_assert("Redo Skip",
+              pos.fen(false) ==
+                  "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq -");
+
+    // Skipping a turn forfeits the en passant capture
+    Position ep("4k3/8/8/8/8/8/3PP3/4K3 w - - 0 1");
+    ep.make(ep.find_move("e2e4"));
+    ep.skip();
+    for (const Move &move : ep.moves()) {
+        mu_assert("Skip Clears En Passant",
+                  move.type() != MoveType::EnPassant);
+    }
+    mu_assert("Skip Hash", ep.hash() == Position(ep.fen()).hash());
+    return 0;
+}
+
+static bool lazy_matches(Position &pos, unsigned depth) {
+    // Query the flags before the move list is generated
+    Position fresh(pos.fen());
+    bool checkmate = fresh.is_checkmate();
+    bool stalemate = fresh.is_stalemate();
+
+    unsigned count = pos.moves().size();
+    bool match = pos.is_check() == fresh.is_check() &&
+                 checkmate == (pos.is_check() && !count) &&
+                 stalemate == (!pos.is_check() && !count) &&
+                 fresh.moves().size() == count;
+    if (!depth) return match;
+
+    for (const Move &move : pos.moves()) {
+        pos.make(move);
+        match &= lazy_matches(pos, depth - 1);
+        pos.undo();
+    }
+    return match;
+}
+
+static char *test_lazy_moves() {
+    Position checkmate("8/8/8/8/8/5k2/8/5K1r w - - 0 1");
+    mu_assert("Checkmate Check", checkmate.is_check());
+    mu_assert("Checkmate", checkmate.is_checkmate());
+
+    Position stalemate("k7/2Q5/1K6/8/8/8/8/8 b - - 0 1");
+    mu_assert("Stalemate Check", !stalemate.is_check());
+    mu_assert("Stalemate", stalemate.is_stalemate());
+
+    Position evasion("4k3/8/8/8/8/5n2/8/R3K3 w Q - 0 1");
+    mu_assert("Knight Check", evasion.is_check());
+    mu_assert("Not Checkmate", !evasion.is_checkmate());
+
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/k1P5/8/1K6/8/8/8/8 w - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        mu_assert("Lazy Moves", lazy_matches(pos, 3));
+    }
+    return 0;
+}
+
+/**
+ * @brief Check every encodable move against the legal move list, for the
+ * position and its children up to the given depth.
+ *
+ * @param pos
+ * @param depth
+ * @return true
+ * @return false
+ */
+static bool validation_matches(Position &pos, Depth depth) {
+    MoveList legal = pos.moves();
+    for (unsigned src = 0; src < 64; src++) {
+        for (unsigned dst = 0; dst < 64; dst++) {
+            for (unsigned type = 0; type <= MoveType::QueenPromoCapture;
+                 type++) {
+                Move move(static_cast<Square>(src),
+                          static_cast<Square>(dst),
+                          static_cast<MoveType>(type));
+                bool expected =
+                    std::find(legal.begin(), legal.end(), move) != legal.end();
+                bool valid = pos.is_pseudo_legal(move) && pos.is_legal(move);
+                if (valid != expected) return false;
+            }
+        }
+    }
+
+    if (depth == 0) return true;
+    bool match = true;
+    for (Move move : legal) {
+        pos.make(move);
+        match &= validation_matches(pos, depth - 1);
+        pos.undo();
+    }
+    return match;
+}
+
+static char *test_move_validation() {
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1",
+        "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1",
+        "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        mu_assert("Move Validation", validation_matches(pos, 1));
+    }
+    return 0;
+}
+
+/**
+ * @brief Check the predicted and incremental check flags against a freshly
+ * loaded position, for every move up to the given depth.
+ *
+ * @param pos
+ * @param depth
+ * @return true
+ * @return false
+ */
+static bool checks_match(Position &pos, Depth depth) {
+    if (depth == 0) return true;
+    bool match = true;
+    MoveList legal = pos.moves();
+    for (Move move : legal) {
+        bool gives_check = pos.gives_check(move);
+        pos.make(move);
+        match &= pos.is_check() == Position(pos.fen()).is_check();
+        match &= pos.is_check() == gives_check;
+        match &= checks_match(pos, depth - 1);
+        pos.undo();
+    }
+    return match;
+}
+
+static char *test_gives_check() {
+    // Discovered checks, promotions, castling and en-passant checks
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/R2pP2k/8/8/8/4K3 w - d6 0 1",
+        "5k2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        "1b5k/P7/8/3B4/8/1R2N3/8/K7 w - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position pos(fen);
+        mu_assert("Gives Check", checks_match(pos, 3));
+    }
+    return 0;
+}
+
+static char *test_state_stack() {
+    // Played moves are folded into the history rather than the stack
+    Position pos;
+    pos.play(pos.find_move("e2e4"));
+    pos.play(pos.find_move("e7e5"));
+    mu_assert("Play Rebases", pos.is_start() && pos.is_end());
+
+    // Copies start at the current state of the original
+    pos.make(pos.find_move("g1f3"));
+    Position copy(pos);
+    mu_assert("Copy Rooted", copy.is_start());
+    mu_assert("Copy Fen", copy.fen() == pos.fen());
+    mu_assert("Copy Hash", copy.hash() == pos.hash());
+
+    // The stack holds a full search line without reallocating
+    std::string fen = copy.fen();
+    std::string cycle[] = {"b8c6", "f3g1", "c6b8", "g1f3"};
+    for (unsigned i = 0; i < MAX_STATES - 1; i++) {
+        copy.make(copy.find_move(cycle[i % 4]));
+    }
+    mu_assert("Stack Depth", copy.is_end());
+    for (unsigned i = 0; i < MAX_STATES - 1; i++) {
+        copy.undo();
+    }
+    mu_assert("Stack Unwinds", copy.is_start() && copy.fen() == fen);
+
+    // Assignment reuses the stack of the destination
+    copy = pos;
+    mu_assert("Assign Fen", copy.fen() == pos.fen());
+    return 0;
+}
+
+static char *test_repetition() {
+    std::string shuffle[] = {"g1f3", "b8c6", "f3g1", "c6b8"};
+
+    // Made moves are inside the search tree, so one repeat is a draw
+    Position pos;
+    for (unsigned i = 0; i < 4; i++) {
+        pos.make(pos.find_move(shuffle[i]));
+    }
+    mu_assert("Root Repeated Once", !pos.is_repetition());
+    for (unsigned i = 0; i < 4; i++) {
+        pos.make(pos.find_move(shuffle[i]));
+    }
+    mu_assert("Tree Repetition", pos.is_repetition() && pos.is_draw());
+
+    // Played moves need the position to occur three times
+    Position game;
+    for (unsigned i = 0; i < 4; i++) {
+        game.play(game.find_move(shuffle[i]));
+    }
+    mu_assert("Twofold", !game.is_repetition());
+    for (unsigned i = 0; i < 4; i++) {
+        game.play(game.find_move(shuffle[i]));
+    }
+    mu_assert("Threefold", game.is_repetition() && game.is_draw());
+
+    // Skipped turns cannot be repeated across
+    Position skip;
+    for (unsigned i = 0; i < 4; i++) {
+        skip.make(skip.find_move(i % 2 ? "f3g1" : "g1f3"));
+        skip.skip();
+    }
+    mu_assert("Skip", !skip.is_repetition());
+    return 0;
+}
+
 static char *all_tests() {
     mu_run_test(test_find_move);
+    mu_run_test(test_incremental_keys);
+    mu_run_test(test_material_key);
+    mu_run_test(test_undo_redo);
+    mu_run_test(test_lazy_moves);
+    mu_run_test(test_move_validation);
+    mu_run_test(test_gives_check);
+    mu_run_test(test_state_stack);
+    mu_run_test(test_repetition);
     return 0;
 }
 
@@ -28,11 +28,12 @@ std::vector<MateTestCase> POSITIONS = {
      }},
 };
 
-static char *test_mate_in_n() {
+static char *mate_in_n(unsigned threads) {
     SearchLimits limits;
     for (MateTestCase &test : POSITIONS) {
         Position position(test.fen);
         Search search;
+        search.set_threads(threads);
 
         Color bot_turn = position.turn();
 
@@ -57,6 +58,10 @@ static char *test_mate_in_n() {
     return 0;
 }
 
+static char *test_mate_in_n() { return mate_in_n(1); }
+
+static char *test_mate_in_n_threads() { return mate_in_n(4); }
+
 static char *test_null_move() {
     SearchLimits limits;
     Position position("R6k/6rp/5B2/8/8/8/7P/7K b - - 0 2");
@@ -75,6 +80,7 @@ static char *test_null_move() {
 
 static char *all_tests() {
     mu_run_test(test_mate_in_n);
+    mu_run_test(test_mate_in_n_threads);
     mu_run_test(test_null_move);
     return 0;
 }
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+struct SeeTestCase {
+    std::string fen;
+    std::string move;
+    int result;
+};
+
+static int P = SEE_VALUES[PieceType::Pawn];
+static int N = SEE_VALUES[PieceType::Knight];
+static int R = SEE_VALUES[PieceType::Rook];
+static int Q = SEE_VALUES[PieceType::Queen];
+
+std::vector<SeeTestCase> POSITIONS = {
+    // Undefended pawn
+    {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", P},
+
+    // Long exchange with x-rays on both sides
+    {"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+     "d3e5",
+     P - N},
+
+    // Doubled rooks win the pawn through the x-ray
+    {"3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", P},
+
+    // Defended pawn taken by a rook
+    {"3rk3/8/8/3p4/8/8/3R4/4K3 w - - 0 1", "d2d5", P - R},
+
+    // En passant, then recaptured
+    {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", P},
+    {"4k3/2p5/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 0},
+
+    // Promotion
+    {"8/4P3/8/8/8/8/k7/4K3 w - - 0 1", "e7e8q", Q - P},
+    {"4r3/3P4/8/8/8/8/k7/4K3 w - - 0 1", "d7e8q", R + Q - P},
+
+    // The king cannot recapture a defended piece
+    {"8/8/4k3/3p4/8/1B6/8/3RK3 w - - 0 1", "d1d5", P},
+    {"8/8/4k3/3p4/8/8/8/3RK3 w - - 0 1", "d1d5", P - R},
+};
+
+static char *test_see() {
+    for (SeeTestCase &test : POSITIONS) {
+        Position position(test.fen);
+        Move move = position.find_move(test.move);
+        Value value = see(position, move);
+
+        std::cout << "see(`" << test.fen << "`, " << test.move
+                  << ") = " << value << " == " << test.result << "?\n";
+        mu_assert("SEE value", value == test.result);
+        mu_assert("SEE threshold", see_ge(position, move, test.result));
+        mu_assert("SEE threshold exceeded",
+                  !see_ge(position, move, test.result + 1));
+    }
+    return 0;
+}
+
+static char *test_see_ge_matches_see() {
+    std::string fens[] = {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+    };
+    for (std::string &fen : fens) {
+        Position position(fen);
+        for (Move move : position.moves()) {
+            Value value = see(position, move);
+            for (Value threshold = -100; threshold <= 100; threshold++) {
+                bool expected = value >= threshold;
+                mu_assert("see_ge",
+                          see_ge(position, move, threshold) == expected);
+            }
+        }
+    }
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_see);
+    mu_run_test(test_see_ge_matches_see);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
\ No newline at end of file
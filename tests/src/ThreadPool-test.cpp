@@ -0,0 +1,66 @@
+#include <atomic>
+#include <iostream>
+
+#include "../../src/Engine.hpp"
+
+#include "ctest.hpp"
+
+using namespace Brainiac;
+
+int tests_run = 0;
+
+static char *test_thread_pool_wait() {
+    ThreadPool pool(4);
+    mu_assert("Pool size", pool.size() == 4);
+
+    std::atomic<unsigned> count = 0;
+    for (unsigned i = 0; i < 100; i++) {
+        pool.submit([&]() { count++; });
+    }
+    pool.wait();
+    mu_assert("All tasks completed", count == 100);
+
+    // The pool is reusable after waiting
+    for (unsigned i = 0; i < 100; i++) {
+        pool.submit([&]() { count++; });
+    }
+    pool.wait();
+    mu_assert("All tasks completed again", count == 200);
+    return 0;
+}
+
+static char *test_thread_pool_resize() {
+    ThreadPool pool(1);
+
+    std::atomic<unsigned> count = 0;
+    for (unsigned i = 0; i < 10; i++) {
+        pool.submit([&]() { count++; });
+    }
+    pool.resize(3);
+    mu_assert("Resize finishes pending tasks", count == 10);
+    mu_assert("Resized pool size", pool.size() == 3);
+
+    pool.submit([&]() { count++; });
+    pool.wait();
+    mu_assert("Resized pool runs tasks", count == 11);
+    return 0;
+}
+
+static char *all_tests() {
+    mu_run_test(test_thread_pool_wait);
+    mu_run_test(test_thread_pool_resize);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    init();
+    char *result = all_tests();
+    if (result != 0) {
+        std::cout << "FAILED... " << result << "\n";
+    } else {
+        std::cout << "ALL TESTS PASSED\n";
+    }
+    std::cout << "Number of tests run: " << tests_run << "\n";
+
+    return result != 0;
+}
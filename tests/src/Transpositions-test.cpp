@@ -1,4 +1,9 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "../../src/Engine.hpp"
 
@@ -30,12 +35,15 @@ static char *test_transpositions_set() {
     table.set(position, type, depth, value, move);
 
     Node node = table.get(position);
-    mu_assert("Transposition Node Hash", node.hash == position.hash());
     mu_assert("Transposition Node Type", node.type == type);
     mu_assert("Transposition Node Depth", node.depth == depth);
     mu_assert("Transposition Node Value", node.value == value);
     mu_assert("Transposition Node Move", node.move == move);
 
+    // Same cluster, different key bits
+    Node other = table.get(position.hash() ^ (1ULL << 63));
+    mu_assert("Transposition Key Mismatch", other.type == NodeType::Invalid);
+
     return 0;
 }
 
@@ -61,7 +69,6 @@ static char *test_transpositions_overwrite() {
     table.set(position, new_type, new_depth, new_value, new_move);
 
     Node node = table.get(position);
-    mu_assert("Overtwrite Node Hash", node.hash == position.hash());
     mu_assert("Overtwrite Node Type", node.type == new_type);
     mu_assert("Overtwrite Node Depth", node.depth == new_depth);
     mu_assert("Overtwrite Node Value", node.value == new_value);
@@ -77,7 +84,6 @@ static char *test_transpositions_overwrite() {
     table.set(position, new_type, new_depth, new_value, new_move);
 
     node = table.get(position);
-    mu_assert("Overtwrite Node Hash", node.hash == position.hash());
     mu_assert("Overtwrite Node Type", node.type == new_type);
     mu_assert("Overtwrite Node Depth", node.depth == new_depth);
     mu_assert("Overtwrite Node Value", node.value == new_value);
@@ -93,7 +99,6 @@ static char *test_transpositions_overwrite() {
     table.set(position, skip_type, skip_depth, skip_value, skip_move);
 
     node = table.get(position);
-    mu_assert("Overtwrite Node Hash", node.hash == position.hash());
     mu_assert("Overtwrite Node Type", node.type == new_type);
     mu_assert("Overtwrite Node Depth", node.depth == new_depth);
     mu_assert("Overtwrite Node Value", node.value == new_value);
@@ -120,11 +125,244 @@ static char *test_transpositions_clear() {
     return 0;
 }
 
+static char *test_transpositions_resize() {
+    Transpositions table(1);
+    std::size_t entries_per_mb = (1 << 20) / sizeof(Entry);
+    mu_assert("Initial capacity", table.capacity() == entries_per_mb);
+
+    Position position;
+    Move move(Square::E2, Square::E4, MoveType::Quiet);
+    table.set(position, NodeType::Exact, 3, 32, move);
+
+    ThreadPool pool(2);
+    table.resize(4, pool);
+    mu_assert("Resized capacity", table.capacity() == 4 * entries_per_mb);
+
+    Node empty = table.get(position);
+    mu_assert("Resize clears", empty.type == NodeType::Invalid);
+
+    table.set(position, NodeType::Exact, 3, 32, move);
+    Node node = table.get(position);
+    mu_assert("Resized Node Move", node.move == move);
+
+    return 0;
+}
+
+static char *test_transpositions_concurrent() {
+    Transpositions table;
+    Position position;
+
+    // Each writer stores entries where the move is derived from the value
+    auto expected_move = [](Value value) {
+        return Move(static_cast<Square>(value & 63),
+                    static_cast<Square>((value * 7) & 63),
+                    MoveType::Quiet);
+    };
+
+    std::atomic_bool done = false;
+    std::vector<std::thread> writers;
+    for (Value w = 0; w < 4; w++) {
+        writers.emplace_back([&, w]() {
+            Position copy = position;
+            for (Value i = 0; i < 20000; i++) {
+                Value value = (i * 4 + w) & 0x3FF;
+                Move move = expected_move(value);
+                table.set(copy, NodeType::Exact, 1, value, move);
+            }
+        });
+    }
+
+    bool consistent = true;
+    std::thread reader([&]() {
+        while (!done) {
+            Node node = table.get(position);
+            if (node.type == NodeType::Invalid) continue;
+            consistent &= node.depth == 1;
+            consistent &= node.move == expected_move(node.value);
+        }
+    });
+
+    for (std::thread &writer : writers) writer.join();
+    done = true;
+    reader.join();
+
+    mu_assert("Concurrent entries consistent", consistent);
+    return 0;
+}
+
+static char *test_transpositions_hit_rate() {
+    // Small table so it saturates after the first generation
+    Transpositions table(1);
+    const unsigned capacity = table.capacity();
+
+    // Simulate a long analysis where each search stores as many fresh
+    // positions as the table can hold, then probes the most recent half
+    Hash state = 0;
+    auto next_hash = [&]() {
+        Hash z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+
+    std::vector<float> hit_rates;
+    std::vector<Hash> hashes(capacity);
+    for (unsigned generation = 0; generation < 32; generation++) {
+        table.next_generation();
+        for (unsigned i = 0; i < capacity; i++) {
+            hashes[i] = next_hash();
+            Depth depth = 1 + (hashes[i] % 12);
+            table.set(hashes[i], NodeType::Exact, depth, 0, Move());
+        }
+
+        unsigned hits = 0;
+        for (unsigned i = capacity / 2; i < capacity; i++) {
+            hits += table.get(hashes[i]).type != NodeType::Invalid;
+        }
+        hit_rates.push_back(hits / (capacity / 2.0f));
+    }
+
+    // The first generation fills an empty table, compare against the first
+    // saturated one
+    for (float hit_rate : hit_rates) {
+        std::cout << "Hit rate " << hit_rate << "\n";
+        mu_assert("Hit rate too low", hit_rate >= 0.5f);
+        mu_assert("Hit rate steady", hit_rate >= hit_rates[1] * 0.95f);
+    }
+    return 0;
+}
+
+static char *test_transpositions_stats() {
+    Transpositions table(1);
+    TableStats stats;
+    Move move(Square::E2, Square::E4, MoveType::Quiet);
+
+    // Hashes sharing the low bits map to the same cluster
+    auto cluster_hash = [](Hash key) { return (key << 48) | 0x1234; };
+
+    table.get(cluster_hash(1), &stats);
+    mu_assert("Stats Probes", stats.probes == 1);
+    mu_assert("Stats Empty Miss", stats.hits == 0 && stats.collisions == 0);
+
+    for (Hash key = 1; key <= CLUSTER_SIZE; key++) {
+        table.set(cluster_hash(key), NodeType::Exact, 1, 0, move, &stats);
+    }
+    mu_assert("Stats Free Slots", stats.overwrites == 0);
+
+    table.get(cluster_hash(1), &stats);
+    mu_assert("Stats Hit", stats.hits == 1);
+
+    table.get(cluster_hash(CLUSTER_SIZE + 1), &stats);
+    mu_assert("Stats Collision", stats.collisions == 1);
+
+    table.set(cluster_hash(CLUSTER_SIZE + 1),
+              NodeType::Exact,
+              2,
+              0,
+              move,
+              &stats);
+    mu_assert("Stats Overwrite", stats.overwrites == 1);
+
+    TableStats total;
+    total += stats;
+    total += stats;
+    mu_assert("Stats Sum", total.probes == 2 * stats.probes);
+    stats.reset();
+    mu_assert("Stats Reset", stats.load().probes == 0);
+
+    return 0;
+}
+
+static char *test_transpositions_hashfull() {
+    Transpositions table(1);
+    mu_assert("Hashfull Empty", table.hashfull() == 0);
+
+    Move move(Square::E2, Square::E4, MoveType::Quiet);
+    std::size_t clusters = table.capacity() / CLUSTER_SIZE;
+    for (std::size_t i = 0; i < clusters; i++) {
+        // Smallest low word that maps to cluster i
+        Hash low = ((i << 32) + clusters - 1) / clusters;
+        for (Hash key = 1; key <= CLUSTER_SIZE; key++) {
+            table.set((key << 48) | low, NodeType::Exact, 1, 0, move);
+        }
+    }
+    mu_assert("Hashfull Full", table.hashfull() == 1000);
+
+    table.next_generation();
+    mu_assert("Hashfull Aged", table.hashfull() == 0);
+
+    return 0;
+}
+
+static char *test_transpositions_save_load() {
+    std::string path =
+        (std::filesystem::temp_directory_path() / "brainiac-tt-test.bin")
+            .string();
+
+    Transpositions table(1);
+    Position position;
+    Move move(Square::E2, Square::E4, MoveType::Quiet);
+    table.set(position, NodeType::Lower, 5, 48, move);
+    mu_assert("Save Table", table.save(path));
+
+    // Tamper with the seed of a copy of the file
+    std::string tampered = path + ".seed";
+    std::filesystem::copy_file(
+        path, tampered, std::filesystem::copy_options::overwrite_existing);
+    std::fstream file(tampered,
+                      std::ios::binary | std::ios::in | std::ios::out);
+    uint64_t seed = ZOBRIST_SEED + 1;
+    file.seekp(offsetof(TableHeader, seed));
+    file.write(reinterpret_cast<char *>(&seed), sizeof(seed));
+    file.close();
+
+    Transpositions loaded(2);
+    mu_assert("Reject Seed", !loaded.load(tampered));
+    mu_assert("Reject Missing", !loaded.load(path + ".missing"));
+    mu_assert("Rejected Keeps Size", loaded.capacity() == 2 * table.capacity());
+
+    mu_assert("Load Table", loaded.load(path));
+    mu_assert("Loaded Capacity", loaded.capacity() == table.capacity());
+
+    Node node = loaded.get(position);
+    mu_assert("Loaded Node Type", node.type == NodeType::Lower);
+    mu_assert("Loaded Node Depth", node.depth == 5);
+    mu_assert("Loaded Node Value", node.value == 48);
+    mu_assert("Loaded Node Move", node.move == move);
+
+    // Writes go to a private copy, never back to the file
+    loaded.clear();
+    Transpositions reloaded(1);
+    mu_assert("Reload Table", reloaded.load(path));
+    mu_assert("File Unchanged",
+              reloaded.get(position).type == NodeType::Lower);
+
+    // Saving over the file the table is mapped from
+    mu_assert("Save Over Loaded", reloaded.save(path));
+    Transpositions resaved(1);
+    mu_assert("Load Resaved", resaved.load(path));
+    mu_assert("Resaved Node", resaved.get(position).type == NodeType::Lower);
+
+    loaded.resize(1);
+    node = loaded.get(position);
+    mu_assert("Resize After Load", node.type == NodeType::Invalid);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(tampered);
+    return 0;
+}
+
 static char *all_tests() {
     mu_run_test(test_transpositions_initial);
     mu_run_test(test_transpositions_set);
     mu_run_test(test_transpositions_overwrite);
     mu_run_test(test_transpositions_clear);
+    mu_run_test(test_transpositions_resize);
+    mu_run_test(test_transpositions_concurrent);
+    mu_run_test(test_transpositions_hit_rate);
+    mu_run_test(test_transpositions_stats);
+    mu_run_test(test_transpositions_hashfull);
+    mu_run_test(test_transpositions_save_load);
     return 0;
 }
 